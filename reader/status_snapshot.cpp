@@ -0,0 +1,180 @@
+#include "status_snapshot.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char *const kSegmentBaseName = "status-active-snapshot";
+    constexpr int kMaxReadAttempts = 1024;
+
+    uint32_t loadSequence(const StatusSnapshotSegment *segment) {
+        return *reinterpret_cast<const volatile uint32_t *>(&segment->sequence);
+    }
+}
+
+struct StatusSnapshotReader {
+    const StatusSnapshotSegment *segment;
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+};
+
+namespace {
+    void unmapSegment(StatusSnapshotReader *reader) {
+#ifdef _WIN32
+        UnmapViewOfFile(reader->segment);
+        CloseHandle(reader->mapping);
+#else
+        munmap(const_cast<StatusSnapshotSegment *>(reader->segment), sizeof(StatusSnapshotSegment));
+#endif
+        reader->segment = nullptr;
+    }
+
+    /**
+     * 按名称映射当前的共享内存段并检查布局版本
+     */
+    int mapSegment(StatusSnapshotReader *reader) {
+        char name[STATUS_SNAPSHOT_NAME_BYTES];
+        status_snapshot_segment_name(name, sizeof(name));
+
+#ifdef _WIN32
+        HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+        if (mapping == nullptr) {
+            return STATUS_SNAPSHOT_NOT_RUNNING;
+        }
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(StatusSnapshotSegment));
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            return STATUS_SNAPSHOT_NOT_RUNNING;
+        }
+        reader->mapping = mapping;
+#else
+        int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) {
+            return STATUS_SNAPSHOT_NOT_RUNNING;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(StatusSnapshotSegment))) {
+            close(fd);
+            return STATUS_SNAPSHOT_NOT_RUNNING;
+        }
+        void *view = mmap(nullptr, sizeof(StatusSnapshotSegment), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED) {
+            return STATUS_SNAPSHOT_NOT_RUNNING;
+        }
+#endif
+
+        reader->segment = static_cast<const StatusSnapshotSegment *>(view);
+        if (reader->segment->magic != STATUS_SNAPSHOT_MAGIC || reader->segment->version != STATUS_SNAPSHOT_VERSION) {
+            unmapSegment(reader);
+            return STATUS_SNAPSHOT_BAD_VERSION;
+        }
+        return STATUS_SNAPSHOT_OK;
+    }
+
+    /**
+     * 按seqlock复制一次快照，返回复制时的写入方实例标识
+     */
+    int copySnapshot(const StatusSnapshotSegment *segment, StatusSnapshot *snapshot, uint32_t *instance) {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            uint32_t before = loadSequence(segment);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (before & 1u) {
+                continue; // 写入中
+            }
+
+            std::memcpy(snapshot, &segment->snapshot, sizeof(StatusSnapshot));
+            *instance = segment->instance;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (loadSequence(segment) == before) {
+                if (snapshot->entryCount > STATUS_SNAPSHOT_MAX_ENTRIES) {
+                    snapshot->entryCount = STATUS_SNAPSHOT_MAX_ENTRIES;
+                }
+                return STATUS_SNAPSHOT_OK;
+            }
+        }
+        return STATUS_SNAPSHOT_BUSY;
+    }
+}
+
+extern "C" void status_snapshot_segment_name(char *buffer, size_t size) {
+    if (buffer == nullptr || size == 0) {
+        return;
+    }
+#ifdef _WIN32
+    // 文件映射默认位于当前会话的 Local\ 命名空间，按会话隔离
+    std::snprintf(buffer, size, "%s", kSegmentBaseName);
+#else
+    // POSIX共享内存为全局命名空间，按用户区分
+    std::snprintf(buffer, size, "/%s-%u", kSegmentBaseName, static_cast<unsigned>(getuid()));
+#endif
+}
+
+extern "C" int status_snapshot_open(StatusSnapshotReader **reader) {
+    if (reader == nullptr) {
+        return STATUS_SNAPSHOT_INVALID;
+    }
+    *reader = nullptr;
+
+    StatusSnapshotReader *result = new (std::nothrow) StatusSnapshotReader;
+    if (result == nullptr) {
+        return STATUS_SNAPSHOT_INVALID;
+    }
+    int error = mapSegment(result);
+    if (error != STATUS_SNAPSHOT_OK) {
+        delete result;
+        return error;
+    }
+    *reader = result;
+    return STATUS_SNAPSHOT_OK;
+}
+
+extern "C" int status_snapshot_read(StatusSnapshotReader *reader, StatusSnapshot *snapshot) {
+    if (reader == nullptr || snapshot == nullptr) {
+        return STATUS_SNAPSHOT_INVALID;
+    }
+
+    if (reader->segment != nullptr) {
+        uint32_t instance = 0;
+        int error = copySnapshot(reader->segment, snapshot, &instance);
+        if (error != STATUS_SNAPSHOT_OK || instance != 0) {
+            return error;
+        }
+        // 写入方已退出，所映射的段不会再更新
+        unmapSegment(reader);
+    }
+
+    // 重新打开：应用可能已重新启动并创建了新的段
+    int error = mapSegment(reader);
+    if (error != STATUS_SNAPSHOT_OK) {
+        return error;
+    }
+    uint32_t instance = 0;
+    error = copySnapshot(reader->segment, snapshot, &instance);
+    if (error == STATUS_SNAPSHOT_OK && instance == 0) {
+        return STATUS_SNAPSHOT_NOT_RUNNING;
+    }
+    return error;
+}
+
+extern "C" void status_snapshot_close(StatusSnapshotReader *reader) {
+    if (reader == nullptr) {
+        return;
+    }
+    if (reader->segment != nullptr) {
+        unmapSegment(reader);
+    }
+    delete reader;
+}
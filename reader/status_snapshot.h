@@ -0,0 +1,92 @@
+#ifndef STATUS_SNAPSHOT_H
+#define STATUS_SNAPSHOT_H
+
+/*
+ * 当前有效状态的共享内存快照
+ *
+ * 状态显示应用运行时，把当前有效的状态和下一次变化的时间发布到一段
+ * 共享内存中；其他进程（shell提示符、桌面小部件等）通过本库读取，
+ * 不需要解析 status.json，也不依赖Qt。
+ *
+ * 写入方使用seqlock：更新期间 sequence 为奇数，读取方复制数据前后
+ * 比较 sequence，不一致则重试，整个过程无锁。
+ *
+ * 应用每次启动生成一个非0的 instance，正常退出时改为0。长时间运行的读取方
+ * 读到0时说明所映射的段已被废弃（POSIX下可能已被删除，重新启动的应用会创建
+ * 新的段），会自动按名称重新打开，打开失败时返回 STATUS_SNAPSHOT_NOT_RUNNING。
+ *
+ * 用法：
+ *     StatusSnapshotReader *reader = NULL;
+ *     if (status_snapshot_open(&reader) == STATUS_SNAPSHOT_OK) {
+ *         StatusSnapshot snapshot;
+ *         if (status_snapshot_read(reader, &snapshot) == STATUS_SNAPSHOT_OK) {
+ *             for (uint32_t i = 0; i < snapshot.entryCount; ++i)
+ *                 printf("%s ", snapshot.entries[i].icon);
+ *         }
+ *         status_snapshot_close(reader);
+ *     }
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STATUS_SNAPSHOT_MAGIC 0x53544153u /* "SATS" */
+#define STATUS_SNAPSHOT_VERSION 2u
+#define STATUS_SNAPSHOT_MAX_ENTRIES 32
+#define STATUS_SNAPSHOT_ICON_BYTES 16
+#define STATUS_SNAPSHOT_DESCRIPTION_BYTES 112
+#define STATUS_SNAPSHOT_NAME_BYTES 64
+
+/* 返回值 */
+#define STATUS_SNAPSHOT_OK 0
+#define STATUS_SNAPSHOT_NOT_RUNNING (-1)   /* 应用未运行（共享内存不存在） */
+#define STATUS_SNAPSHOT_BAD_VERSION (-2)   /* 布局版本不兼容 */
+#define STATUS_SNAPSHOT_BUSY (-3)          /* 多次重试后仍在写入中 */
+#define STATUS_SNAPSHOT_INVALID (-4)       /* 参数错误 */
+
+/* 一个有效状态，时间均为UTC秒数（Unix时间戳），字符串为UTF-8并以'\0'结尾 */
+typedef struct StatusSnapshotEntry {
+    int64_t startSecs;
+    int64_t endSecs;
+    char icon[STATUS_SNAPSHOT_ICON_BYTES];
+    char description[STATUS_SNAPSHOT_DESCRIPTION_BYTES];
+} StatusSnapshotEntry;
+
+/* 读取到的快照 */
+typedef struct StatusSnapshot {
+    uint32_t activeCount;    /* 当前有效状态总数，可能大于 entryCount */
+    uint32_t entryCount;     /* entries 中的有效项数 */
+    int64_t publishedAt;     /* 发布时间 */
+    int64_t nextTransition;  /* 下一次有状态开始或结束的时间，-1 表示没有 */
+    StatusSnapshotEntry entries[STATUS_SNAPSHOT_MAX_ENTRIES];
+} StatusSnapshot;
+
+/* 共享内存布局（写入方与读取方共用） */
+typedef struct StatusSnapshotSegment {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;
+    uint32_t instance;  /* 写入方实例标识，0 表示已废弃 */
+    StatusSnapshot snapshot;
+} StatusSnapshotSegment;
+
+typedef struct StatusSnapshotReader StatusSnapshotReader;
+
+/* 当前用户的共享内存名称（Windows为文件映射名，POSIX为shm_open名称） */
+void status_snapshot_segment_name(char *buffer, size_t size);
+
+int status_snapshot_open(StatusSnapshotReader **reader);
+
+int status_snapshot_read(StatusSnapshotReader *reader, StatusSnapshot *snapshot);
+
+void status_snapshot_close(StatusSnapshotReader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_SNAPSHOT_H */
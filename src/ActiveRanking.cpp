@@ -0,0 +1,151 @@
+#include "ActiveRanking.h"
+#include <tuple>
+
+namespace {
+    /**
+     * @brief 排名键之后的附加比较，使内容不同的状态不会被视为相等
+     */
+    bool contentLess(const StatusData &lhs, const StatusData &rhs) {
+        return std::tie(lhs.uid, lhs.icon, lhs.description) < std::tie(rhs.uid, rhs.icon, rhs.description);
+    }
+
+    /**
+     * @brief 在多重集合中删除与 entry 完全相同的一项
+     */
+    template <typename Set, typename Entry>
+    bool eraseOne(Set &set, const Entry &entry) {
+        auto it = set.find(entry);
+        if (it == set.end()) {
+            return false;
+        }
+        set.erase(it);
+        return true;
+    }
+}
+
+bool ActiveRanking::RankLess::operator()(const Entry &lhs, const Entry &rhs) const {
+    const StatusData &a = lhs.status;
+    const StatusData &b = rhs.status;
+    if (a.priority != b.priority) return a.priority > b.priority;  // 优先级高的在前
+    if (lhs.end != rhs.end) return lhs.end < rhs.end;              // 先结束的在前
+    if (lhs.start != rhs.start) return lhs.start > rhs.start;      // 最近开始的在前
+    return contentLess(a, b);
+}
+
+bool ActiveRanking::StartLess::operator()(const Entry &lhs, const Entry &rhs) const {
+    if (lhs.start != rhs.start) return lhs.start < rhs.start;
+    return RankLess()(lhs, rhs);
+}
+
+bool ActiveRanking::EndLess::operator()(const Entry &lhs, const Entry &rhs) const {
+    if (lhs.end != rhs.end) return lhs.end < rhs.end;
+    return RankLess()(lhs, rhs);
+}
+
+ActiveRanking::ActiveRanking()
+    : m_now(QDateTime::currentSecsSinceEpoch()) {
+}
+
+bool ActiveRanking::makeEntry(const StatusData &status, Entry &entry) {
+    if (!status.startDateTime.isValid()) {
+        return false;
+    }
+    entry.start = status.startDateTime.toSecsSinceEpoch();
+    entry.end = entry.start + status.durationHours * qint64(3600);
+    entry.status = status;
+    return true;
+}
+
+void ActiveRanking::reset(const QVector<StatusData> &statuses, const QDateTime &now) {
+    m_upcoming.clear();
+    m_active.clear();
+    m_ends.clear();
+    m_now = now.toSecsSinceEpoch();
+    for (const StatusData &status : statuses) {
+        insert(status);
+    }
+}
+
+void ActiveRanking::activate(const Entry &entry) {
+    m_active.insert(entry);
+    m_ends.insert(entry);
+}
+
+void ActiveRanking::insert(const StatusData &status) {
+    Entry entry;
+    if (!makeEntry(status, entry)) {
+        return;
+    }
+    if (entry.start > m_now) {
+        m_upcoming.insert(entry);
+    } else if (entry.end > m_now) {
+        activate(entry);
+    }
+    // 已结束的状态不再参与排名
+}
+
+void ActiveRanking::remove(const StatusData &status) {
+    Entry entry;
+    if (!makeEntry(status, entry)) {
+        return;
+    }
+    if (entry.start > m_now) {
+        eraseOne(m_upcoming, entry);
+    } else if (entry.end > m_now) {
+        eraseOne(m_active, entry);
+        eraseOne(m_ends, entry);
+    }
+}
+
+bool ActiveRanking::advance(const QDateTime &now) {
+    const qint64 secs = now.toSecsSinceEpoch();
+    bool changed = false;
+
+    // 已结束的状态不保存，时钟回拨无法在这里恢复，由调用方用全部状态 reset()
+    if (secs < m_now) {
+        return false;
+    }
+    m_now = secs;
+
+    while (!m_upcoming.empty() && m_upcoming.begin()->start <= m_now) {
+        Entry entry = *m_upcoming.begin();
+        m_upcoming.erase(m_upcoming.begin());
+        if (entry.end > m_now) {
+            activate(entry);
+        }
+        changed = true;
+    }
+
+    while (!m_ends.empty() && m_ends.begin()->end <= m_now) {
+        eraseOne(m_active, *m_ends.begin());
+        m_ends.erase(m_ends.begin());
+        changed = true;
+    }
+
+    return changed;
+}
+
+QVector<StatusData> ActiveRanking::top(qsizetype k) const {
+    qsizetype count = activeCount();
+    if (k >= 0 && k < count) {
+        count = k;
+    }
+
+    QVector<StatusData> result;
+    result.reserve(count);
+    for (auto it = m_active.cbegin(); it != m_active.cend() && result.size() < count; ++it) {
+        result.append(it->status);
+    }
+    return result;
+}
+
+qint64 ActiveRanking::nextTransition() const {
+    qint64 next = -1;
+    if (!m_upcoming.empty()) {
+        next = m_upcoming.begin()->start;
+    }
+    if (!m_ends.empty() && (next < 0 || m_ends.begin()->end < next)) {
+        next = m_ends.begin()->end;
+    }
+    return next;
+}
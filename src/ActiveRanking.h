@@ -0,0 +1,91 @@
+#ifndef ACTIVERANKING_H
+#define ACTIVERANKING_H
+
+#include <QDateTime>
+#include <QVector>
+#include <set>
+#include "StatusData.h"
+
+/**
+ * @brief 当前有效状态的排名，增量维护
+ *
+ * 排名规则：优先级高的在前；相同时先结束的在前；再相同时后开始的（最近的）在前。
+ *
+ * 所有状态按所处阶段分别存放：未开始的按起始时间排序，有效的同时按排名和结束时间排序，
+ * 已结束的不保存。添加、删除一个状态以及每个状态的开始、结束都是 O(log n)，
+ * 取前 K 个为 O(K)，没有状态开始或结束时 advance() 为 O(1)。
+ */
+class ActiveRanking {
+public:
+    ActiveRanking();
+
+    /**
+     * @brief 清空后按给定时刻重新建立
+     */
+    void reset(const QVector<StatusData> &statuses, const QDateTime &now);
+
+    void insert(const StatusData &status);
+
+    /**
+     * @brief 删除一个内容、标识相同的状态
+     */
+    void remove(const StatusData &status);
+
+    /**
+     * @brief 推进到指定时刻，处理期间开始和结束的状态
+     *
+     * 只能向后推进：早于上次时刻时不做任何处理，调用方需改用 reset() 传入全部状态重建。
+     * @return 有效集合是否变化
+     */
+    bool advance(const QDateTime &now);
+
+    /**
+     * @brief 排名前 k 的有效状态（k < 0 表示全部）
+     */
+    QVector<StatusData> top(qsizetype k) const;
+
+    qsizetype activeCount() const { return static_cast<qsizetype>(m_active.size()); }
+
+    /**
+     * @brief 下一次有状态开始或结束的时间（UTC秒），没有时返回 -1
+     */
+    qint64 nextTransition() const;
+
+    /**
+     * @brief 上一次推进到的时刻（UTC秒）
+     */
+    qint64 currentSecs() const { return m_now; }
+
+private:
+    struct Entry {
+        qint64 start;
+        qint64 end;
+        StatusData status;
+    };
+
+    /**
+     * @brief 排名顺序；内容也参与比较，保证是全序
+     */
+    struct RankLess {
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+    };
+
+    struct StartLess {
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+    };
+
+    struct EndLess {
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+    };
+
+    static bool makeEntry(const StatusData &status, Entry &entry);
+
+    void activate(const Entry &entry);
+
+    std::multiset<Entry, StartLess> m_upcoming;  // 未开始
+    std::multiset<Entry, RankLess> m_active;     // 有效，按排名
+    std::multiset<Entry, EndLess> m_ends;        // 有效，按结束时间
+    qint64 m_now;
+};
+
+#endif // ACTIVERANKING_H
@@ -0,0 +1,162 @@
+#include "ActiveSnapshotPublisher.h"
+#include "status_snapshot.h"
+#include <QDebug>
+#include <QRandomGenerator>
+#include <atomic>
+#include <cstring>
+
+namespace {
+    QNativeIpcKey snapshotKey() {
+        char name[STATUS_SNAPSHOT_NAME_BYTES];
+        status_snapshot_segment_name(name, sizeof(name));
+#ifdef Q_OS_WIN
+        return QNativeIpcKey(QString::fromLatin1(name), QNativeIpcKey::Type::Windows);
+#else
+        return QNativeIpcKey(QString::fromLatin1(name), QNativeIpcKey::Type::PosixRealtime);
+#endif
+    }
+
+    /**
+     * @brief 复制UTF-8字符串，截断时不拆开多字节字符
+     */
+    void copyUtf8(char *target, int capacity, const QString &text) {
+        QByteArray utf8 = text.toUtf8();
+        int length = qMin<int>(utf8.size(), capacity - 1);
+        while (length > 0 && length < utf8.size() && (static_cast<unsigned char>(utf8[length]) & 0xC0) == 0x80) {
+            --length;
+        }
+        std::memcpy(target, utf8.constData(), length);
+        std::memset(target + length, 0, capacity - length);
+    }
+}
+
+ActiveSnapshotPublisher::ActiveSnapshotPublisher(StatusManager *manager, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager)
+      , m_sharedMemory(snapshotKey())
+      , m_publishedTransition(-1) {
+    m_transitionTimer = new QTimer(this);
+    m_transitionTimer->setSingleShot(true);
+    m_transitionTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_transitionTimer, &QTimer::timeout, this, &ActiveSnapshotPublisher::publish);
+
+    connect(m_statusManager, &StatusManager::statusesChanged,
+            this, &ActiveSnapshotPublisher::publish);
+}
+
+ActiveSnapshotPublisher::~ActiveSnapshotPublisher() {
+    // 标记为已废弃，仍映射着本段的读取方会重新打开
+    if (m_sharedMemory.isAttached()) {
+        writeInstance(0);
+    }
+    m_sharedMemory.detach();
+}
+
+bool ActiveSnapshotPublisher::start() {
+    if (!m_sharedMemory.create(sizeof(StatusSnapshotSegment))) {
+        // 上次异常退出可能留下同名共享内存，直接接管
+        if (m_sharedMemory.error() != QSharedMemory::AlreadyExists || !m_sharedMemory.attach()) {
+            qWarning() << "无法创建共享内存:" << m_sharedMemory.errorString();
+            return false;
+        }
+        if (m_sharedMemory.size() < static_cast<qsizetype>(sizeof(StatusSnapshotSegment))) {
+            qWarning() << "共享内存大小不匹配";
+            m_sharedMemory.detach();
+            return false;
+        }
+    }
+
+    StatusSnapshotSegment *segment = static_cast<StatusSnapshotSegment *>(m_sharedMemory.data());
+    std::memset(segment, 0, sizeof(StatusSnapshotSegment));
+    segment->snapshot.nextTransition = -1;
+    segment->magic = STATUS_SNAPSHOT_MAGIC;
+    segment->version = STATUS_SNAPSHOT_VERSION;
+    writeInstance(QRandomGenerator::global()->bounded(1u, 0xFFFFFFFFu));
+
+    // 强制首次写入
+    m_published.clear();
+    m_publishedTransition = -2;
+    publish();
+    return true;
+}
+
+void ActiveSnapshotPublisher::publish() {
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QVector<StatusData> active;
+    qint64 nextTransition = -1;
+
+    for (const StatusData &status : m_statusManager->getAllStatuses()) {
+        if (!status.startDateTime.isValid()) {
+            continue;
+        }
+        qint64 start = status.startDateTime.toSecsSinceEpoch();
+        qint64 end = start + status.durationHours * qint64(3600);
+
+        qint64 transition = -1;
+        if (now < start) {
+            transition = start;
+        } else if (now < end) {
+            active.append(status);
+            transition = end;
+        }
+        if (transition >= 0 && (nextTransition < 0 || transition < nextTransition)) {
+            nextTransition = transition;
+        }
+    }
+
+    if (m_sharedMemory.isAttached()
+        && (active != m_published || nextTransition != m_publishedTransition)) {
+        writeSegment(active, nextTransition);
+        m_published = active;
+        m_publishedTransition = nextTransition;
+    }
+
+    scheduleNext(nextTransition);
+}
+
+void ActiveSnapshotPublisher::writeSegment(const QVector<StatusData> &active, qint64 nextTransition) {
+    StatusSnapshotSegment *segment = static_cast<StatusSnapshotSegment *>(m_sharedMemory.data());
+    std::atomic_ref<uint32_t> sequence(segment->sequence);
+
+    // seqlock：序号变为奇数后写入，完成后再变为偶数
+    uint32_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    StatusSnapshot &snapshot = segment->snapshot;
+    snapshot.activeCount = static_cast<uint32_t>(active.size());
+    snapshot.entryCount = static_cast<uint32_t>(qMin<qsizetype>(active.size(), STATUS_SNAPSHOT_MAX_ENTRIES));
+    snapshot.publishedAt = QDateTime::currentSecsSinceEpoch();
+    snapshot.nextTransition = nextTransition;
+
+    for (uint32_t i = 0; i < snapshot.entryCount; ++i) {
+        const StatusData &status = active[i];
+        StatusSnapshotEntry &entry = snapshot.entries[i];
+        entry.startSecs = status.startDateTime.toSecsSinceEpoch();
+        entry.endSecs = entry.startSecs + status.durationHours * qint64(3600);
+        copyUtf8(entry.icon, STATUS_SNAPSHOT_ICON_BYTES, status.icon);
+        copyUtf8(entry.description, STATUS_SNAPSHOT_DESCRIPTION_BYTES, status.description);
+    }
+
+    sequence.store(current + 2, std::memory_order_release);
+}
+
+void ActiveSnapshotPublisher::writeInstance(uint32_t instance) {
+    StatusSnapshotSegment *segment = static_cast<StatusSnapshotSegment *>(m_sharedMemory.data());
+    std::atomic_ref<uint32_t> sequence(segment->sequence);
+
+    uint32_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->instance = instance;
+    sequence.store(current + 2, std::memory_order_release);
+}
+
+void ActiveSnapshotPublisher::scheduleNext(qint64 nextTransition) {
+    qint64 interval = MAX_TIMER_INTERVAL;
+    if (nextTransition >= 0) {
+        qint64 untilNext = nextTransition * 1000 - QDateTime::currentMSecsSinceEpoch();
+        interval = qBound<qint64>(1, untilNext, MAX_TIMER_INTERVAL);
+    }
+    m_transitionTimer->start(static_cast<int>(interval));
+}
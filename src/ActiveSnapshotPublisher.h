@@ -0,0 +1,53 @@
+#ifndef ACTIVESNAPSHOTPUBLISHER_H
+#define ACTIVESNAPSHOTPUBLISHER_H
+
+#include <QObject>
+#include <QSharedMemory>
+#include <QTimer>
+#include <QVector>
+#include "StatusManager.h"
+
+/**
+ * @brief 把当前有效的状态发布到共享内存，供其他进程读取
+ *
+ * 只在状态数据变化或到达下一次状态开始/结束时间时重新计算，
+ * 有效集合没有变化时不改写共享内存。读取方见 reader/status_snapshot.h。
+ */
+class ActiveSnapshotPublisher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ActiveSnapshotPublisher(StatusManager *manager, QObject *parent = nullptr);
+
+    ~ActiveSnapshotPublisher();
+
+    /**
+     * @brief 创建（或接管残留的）共享内存段并发布一次
+     */
+    bool start();
+
+private slots:
+    void publish();
+
+private:
+    void writeSegment(const QVector<StatusData> &active, qint64 nextTransition);
+
+    /**
+     * @brief 写入实例标识：启动时为随机非0值，退出时为0
+     */
+    void writeInstance(quint32 instance);
+
+    void scheduleNext(qint64 nextTransition);
+
+    StatusManager *m_statusManager;
+    QSharedMemory m_sharedMemory;
+    QTimer *m_transitionTimer;
+
+    // 上一次发布的内容
+    QVector<StatusData> m_published;
+    qint64 m_publishedTransition;
+
+    static const int MAX_TIMER_INTERVAL = 3600 * 1000; // 至少每小时检查一次，应对休眠和时钟调整
+};
+
+#endif // ACTIVESNAPSHOTPUBLISHER_H
@@ -0,0 +1,289 @@
+#include "GuiStressHarness.h"
+#include "MainWindow.h"
+#include "ManageDialog.h"
+#include "StatusManager.h"
+#include <QApplication>
+#include <QDebug>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QWidget>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    const QEvent::Type kProbeEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+    /**
+     * @brief 事件循环延迟探测：记录投递时刻
+     */
+    class ProbeEvent : public QEvent {
+    public:
+        explicit ProbeEvent(qint64 postedAt)
+            : QEvent(kProbeEventType)
+              , postedAt(postedAt) {
+        }
+
+        qint64 postedAt; // 纳秒
+    };
+
+    const QStringList kIcons = {"📚", "💻", "☕", "🏃", "🍔", "😴", "📝", "⚡"};
+
+    StatusData makeStatus(int i, const QDateTime &start) {
+        StatusData status;
+        status.icon = kIcons[i % kIcons.size()];
+        status.description = QString("压力测试 %1").arg(i);
+        status.startDateTime = start;
+        status.durationHours = 1;
+        status.priority = i % 5;
+        return status;
+    }
+}
+
+GuiStressHarness::GuiStressHarness(QObject *parent)
+    : QObject(parent)
+      , m_paintEvents(0)
+      , m_inFrame(false)
+      , m_burstStatuses(5000)
+      , m_tableStatuses(20000)
+      , m_toggles(100)
+      , m_deletes(200)
+      , m_maxLatencyMs(250)
+      , m_maxFrameMs(100)
+      , m_maxWidgets(10000)
+      , m_maxObjects(20000) {
+    m_probeTimer = new QTimer(this);
+    m_probeTimer->setTimerType(Qt::PreciseTimer);
+    m_probeTimer->setInterval(PROBE_INTERVAL);
+    connect(m_probeTimer, &QTimer::timeout, this, &GuiStressHarness::postProbe);
+}
+
+void GuiStressHarness::configure(const QStringList &arguments) {
+    for (const QString &argument : arguments) {
+        if (!argument.startsWith("--") || !argument.contains('=')) {
+            continue;
+        }
+        const QString key = argument.mid(2).section('=', 0, 0);
+        const QString value = argument.section('=', 1);
+
+        bool ok = false;
+        const double number = value.toDouble(&ok);
+        if (!ok) {
+            qWarning() << "无效的参数值:" << argument;
+            continue;
+        }
+        if (key == "statuses") m_burstStatuses = int(number);
+        else if (key == "table-statuses") m_tableStatuses = int(number);
+        else if (key == "toggles") m_toggles = int(number);
+        else if (key == "deletes") m_deletes = int(number);
+        else if (key == "max-latency-ms") m_maxLatencyMs = number;
+        else if (key == "max-frame-ms") m_maxFrameMs = number;
+        else if (key == "max-widgets") m_maxWidgets = int(number);
+        else if (key == "max-objects") m_maxObjects = int(number);
+        else qWarning() << "未知参数:" << argument;
+    }
+}
+
+bool GuiStressHarness::event(QEvent *event) {
+    if (event->type() == kProbeEventType) {
+        m_latencies.append(m_clock.nsecsElapsed() - static_cast<ProbeEvent *>(event)->postedAt);
+        return true;
+    }
+    return QObject::event(event);
+}
+
+bool GuiStressHarness::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::Paint) {
+        ++m_paintEvents;
+    } else if (event->type() == QEvent::UpdateRequest && !m_inFrame && watched->isWidgetType()
+               && static_cast<QWidget *>(watched)->isWindow()) {
+        // 顶层窗口的 UpdateRequest 中绘制所有待更新的部件，即事件循环中的一帧。
+        // 在这里完整投递一次（仍经过其他过滤器）并计时，原事件不再继续处理
+        const int paintsBefore = m_paintEvents;
+        QElapsedTimer timer;
+        timer.start();
+        m_inFrame = true;
+        QCoreApplication::sendEvent(watched, event);
+        m_inFrame = false;
+        if (m_paintEvents > paintsBefore) {
+            recordFrame(timer.nsecsElapsed());
+            ++m_current.frames;
+        }
+        return true;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void GuiStressHarness::recordFrame(qint64 frameNs) {
+    m_current.frameMaxMs = std::max(m_current.frameMaxMs, frameNs / 1e6);
+}
+
+void GuiStressHarness::postProbe() {
+    QCoreApplication::postEvent(this, new ProbeEvent(m_clock.nsecsElapsed()));
+}
+
+void GuiStressHarness::pump(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+void GuiStressHarness::step(const std::function<void()> &operation) {
+    postProbe();
+    operation();
+    pump(0);
+    ++m_current.steps;
+}
+
+void GuiStressHarness::measure(const QList<QWidget *> &windows) {
+    for (QWidget *window : windows) {
+        if (!window || !window->isVisible()) {
+            continue;
+        }
+        const int paintsBefore = m_paintEvents;
+        QElapsedTimer frame;
+        frame.start();
+        window->repaint();
+        if (m_paintEvents > paintsBefore) {
+            recordFrame(frame.nsecsElapsed());
+        }
+    }
+
+    // 有父对象的顶层窗口（如管理界面）已包含在父窗口的子对象中
+    auto treeSize = [](QObject *root) {
+        return 1 + int(root->findChildren<QObject *>().size());
+    };
+    int objects = treeSize(qApp);
+    for (QWidget *widget : QApplication::topLevelWidgets()) {
+        if (!widget->parent()) {
+            objects += treeSize(widget);
+        }
+    }
+    for (QObject *root : std::as_const(m_roots)) {
+        objects += treeSize(root);
+    }
+    m_current.widgets = std::max(m_current.widgets, int(QApplication::allWidgets().size()));
+    m_current.objects = std::max(m_current.objects, objects);
+}
+
+void GuiStressHarness::beginScenario(const QString &name) {
+    pump(0); // 丢弃上一场景遗留的探测事件
+    m_latencies.clear();
+    m_current = ScenarioResult();
+    m_current.name = name;
+}
+
+void GuiStressHarness::endScenario() {
+    pump(PROBE_INTERVAL * 2); // 处理尚未处理的探测事件
+
+    if (!m_latencies.isEmpty()) {
+        std::sort(m_latencies.begin(), m_latencies.end());
+        m_current.latencyMaxMs = m_latencies.last() / 1e6;
+        m_current.latencyP99Ms = m_latencies[(m_latencies.size() - 1) * 99 / 100] / 1e6;
+    }
+
+    const ScenarioResult &r = m_current;
+    std::printf("gui-stress scenario=%s steps=%d latency-max-ms=%.1f latency-p99-ms=%.1f frame-max-ms=%.1f "
+                "frames=%d widgets=%d objects=%d\n",
+                qPrintable(r.name), r.steps, r.latencyMaxMs, r.latencyP99Ms, r.frameMaxMs, r.frames, r.widgets,
+                r.objects);
+    std::fflush(stdout);
+
+    if (r.latencyMaxMs > m_maxLatencyMs) m_violations << r.name + " latency";
+    if (r.frameMaxMs > m_maxFrameMs) m_violations << r.name + " frame";
+    if (r.widgets > m_maxWidgets) m_violations << r.name + " widgets";
+    if (r.objects > m_maxObjects) m_violations << r.name + " objects";
+    m_results.append(m_current);
+}
+
+int GuiStressHarness::run() {
+    // 使用临时目录中的独立数据，不影响用户的 status.json
+    QTemporaryDir dataDir;
+    const QString path = dataDir.filePath("status.json");
+    QFile file(path);
+    if (!dataDir.isValid() || !file.open(QIODevice::WriteOnly)) {
+        qWarning() << "无法创建压力测试数据目录";
+        return 1;
+    }
+    file.write("{\n  \"statuses\": []\n}");
+    file.close();
+
+    StatusManager manager;
+    if (!manager.loadFromFile(path)) {
+        return 1;
+    }
+    MainWindow window(&manager);
+    m_roots = {this, &manager};
+    qApp->installEventFilter(this);
+    window.show();
+
+    m_clock.start();
+    m_probeTimer->start();
+
+    // 一半状态在 BURST_DELAY 秒后同时开始，另一半随后同时结束
+    beginScenario("burst");
+    {
+        const QDateTime now = QDateTime::currentDateTime();
+        QVector<StatusData> statuses;
+        statuses.reserve(m_burstStatuses);
+        for (int i = 0; i < m_burstStatuses; ++i) {
+            statuses.append(makeStatus(i, i % 2 == 0 ? now.addSecs(BURST_DELAY)
+                                                     : now.addSecs(BURST_DELAY + 1 - 3600)));
+        }
+        step([&]() { manager.addStatuses(statuses); });
+        QElapsedTimer waited;
+        waited.start();
+        while (waited.elapsed() < (BURST_DELAY + 2) * 1000) {
+            pump(FRAME_INTERVAL);
+            measure({&window});
+        }
+    }
+    endScenario();
+
+    // 展开时显示全部有效状态
+    beginScenario("toggle");
+    for (int i = 0; i < m_toggles; ++i) {
+        step([&]() { QMetaObject::invokeMethod(&window, "toggleExpanded"); });
+        measure({&window});
+    }
+    endScenario();
+
+    // 大量历史状态下打开管理界面
+    ManageDialog *dialog = nullptr;
+    beginScenario("dialog");
+    {
+        const QDateTime past = QDateTime::currentDateTime().addDays(-30);
+        QVector<StatusData> statuses;
+        statuses.reserve(m_tableStatuses);
+        for (int i = 0; i < m_tableStatuses; ++i) {
+            statuses.append(makeStatus(i, past.addSecs(i * 60)));
+        }
+        step([&]() { manager.addStatuses(statuses); });
+        step([&]() {
+            dialog = new ManageDialog(&manager, &window);
+            dialog->show();
+        });
+        measure({&window, dialog});
+    }
+    endScenario();
+
+    // 管理界面打开时逐个删除，每次删除都会刷新所有表格
+    beginScenario("bulk-delete");
+    for (int i = 0; i < m_deletes && !manager.getAllStatuses().isEmpty(); ++i) {
+        step([&]() { manager.removeStatus(0); });
+        measure({&window, dialog});
+    }
+    endScenario();
+
+    m_probeTimer->stop();
+    qApp->removeEventFilter(this);
+    m_roots.clear();
+    delete dialog;
+
+    for (const QString &violation : std::as_const(m_violations)) {
+        std::printf("gui-stress over-budget %s\n", qPrintable(violation));
+    }
+    std::printf("gui-stress result=%s\n", m_violations.isEmpty() ? "pass" : "fail");
+    std::fflush(stdout);
+    return m_violations.isEmpty() ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#ifndef GUISTRESSHARNESS_H
+#define GUISTRESSHARNESS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+class QWidget;
+
+/**
+ * @brief 界面压力测试（--gui-stress，默认使用 offscreen 平台）
+ *
+ * 在临时目录中用独立的数据运行 MainWindow 和 ManageDialog，依次执行以下场景：
+ *     burst        大量状态在几秒内集中开始和结束
+ *     toggle       反复展开、收起主窗口
+ *     dialog       在大量状态下打开管理界面
+ *     bulk-delete  管理界面打开时逐个删除状态
+ *
+ * 每个场景记录事件循环延迟（投递事件到处理的时间）、每帧绘制时间（事件循环中实际发生的帧，
+ * 以及强制重绘）和窗口部件、对象数量，
+ * 输出一行结果；任一项超出预算时程序以1退出。场景规模和预算可由参数设置，例如：
+ *     status --gui-stress --statuses=5000 --max-latency-ms=250 --max-frame-ms=100
+ */
+class GuiStressHarness : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GuiStressHarness(QObject *parent = nullptr);
+
+    /**
+     * @brief 读取 --名称=值 形式的规模和预算参数
+     */
+    void configure(const QStringList &arguments);
+
+    /**
+     * @brief 运行全部场景
+     * @return 退出码，超出预算或无法运行时为1
+     */
+    int run();
+
+protected:
+    bool event(QEvent *event) override;
+
+    /**
+     * @brief 应用级事件过滤：统计绘制事件，并计时顶层窗口处理 UpdateRequest（一帧）的耗时
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @brief 一个场景的测量结果
+     */
+    struct ScenarioResult {
+        QString name;
+        int steps = 0;
+        double latencyMaxMs = 0;
+        double latencyP99Ms = 0;
+        double frameMaxMs = 0;
+        int frames = 0; // 事件循环中实际发生的绘制帧数
+        int widgets = 0;
+        int objects = 0;
+    };
+
+    void beginScenario(const QString &name);
+
+    void endScenario();
+
+    /**
+     * @brief 先投递一个探测事件再执行操作，探测事件的延迟即包含该操作阻塞事件循环的时间
+     */
+    void step(const std::function<void()> &operation);
+
+    /**
+     * @brief 运行事件循环 ms 毫秒
+     */
+    void pump(int ms);
+
+    void postProbe();
+
+    /**
+     * @brief 同步重绘可见窗口，确有绘制事件时记录耗时，同时记录部件和对象数量
+     *
+     * 对象数量从互不重叠的根对象统计：应用对象、没有父对象的顶层窗口和 m_roots。
+     */
+    void measure(const QList<QWidget *> &windows);
+
+    void recordFrame(qint64 frameNs);
+
+    QElapsedTimer m_clock;
+    QTimer *m_probeTimer;
+    QList<QObject *> m_roots;  // 不属于任何窗口的对象树，如状态管理器和本对象
+    int m_paintEvents;         // 已发生的绘制事件数
+    bool m_inFrame;
+    QVector<qint64> m_latencies; // 纳秒
+    ScenarioResult m_current;
+    QVector<ScenarioResult> m_results;
+    QStringList m_violations;
+
+    // 场景规模
+    int m_burstStatuses;
+    int m_tableStatuses;
+    int m_toggles;
+    int m_deletes;
+
+    // 预算
+    double m_maxLatencyMs;
+    double m_maxFrameMs;
+    int m_maxWidgets;
+    int m_maxObjects;
+
+    static const int PROBE_INTERVAL = 5;    // 探测事件间隔（毫秒）
+    static const int FRAME_INTERVAL = 100;  // 等待期间的重绘间隔（毫秒）
+    static const int BURST_DELAY = 2;       // 状态开始的爆发距添加的时间（秒）
+};
+
+#endif // GUISTRESSHARNESS_H
@@ -0,0 +1,317 @@
+#include "IsoTimestamp.h"
+#include <QHash>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    // 固定格式：yyyy-MM-ddThh:mm:ss，共19个字符，按3个64位字处理
+    constexpr int kIsoLength = 19;
+    constexpr int kWordCount = 3;
+    constexpr char kTemplate[kWordCount * 8] = "0000-00-00T00:00:00";
+    constexpr char kDigitMask[kWordCount * 8] = {
+        1, 1, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 0, 0, 0
+    };
+
+    constexpr uint64_t kHighNibbles = 0xF0F0F0F0F0F0F0F0ULL;
+    constexpr uint64_t kAsciiZeros = 0x3030303030303030ULL;
+    constexpr uint64_t kSixes = 0x0606060606060606ULL;
+
+    constexpr qint64 kSecsPerHour = 3600;
+    constexpr qint64 kSecsPerDay = 86400;
+    constexpr qint64 kUnixEpochJulianDay = 2440588;
+    constexpr int kIrregularOffset = INT_MIN;
+
+    /**
+     * @brief 分隔符模板与数字位置掩码，以64位字形式存放（与字节序无关）
+     */
+    struct LayoutWords {
+        uint64_t separators[kWordCount];
+        uint64_t digits[kWordCount];
+
+        LayoutWords() {
+            unsigned char mask[kWordCount * 8];
+            unsigned char separatorBytes[kWordCount * 8];
+            for (int i = 0; i < kWordCount * 8; ++i) {
+                mask[i] = kDigitMask[i] ? 0xFF : 0x00;
+                separatorBytes[i] = kDigitMask[i] ? 0 : static_cast<unsigned char>(kTemplate[i]);
+            }
+            std::memcpy(digits, mask, sizeof(digits));
+            std::memcpy(separators, separatorBytes, sizeof(separators));
+        }
+    };
+
+    const LayoutWords &layoutWords() {
+        static const LayoutWords words;
+        return words;
+    }
+
+    inline int digitAt(const char *bytes, int index) {
+        return bytes[index] - '0';
+    }
+
+    inline int twoDigits(const char *bytes, int index) {
+        return digitAt(bytes, index) * 10 + digitAt(bytes, index + 1);
+    }
+
+    inline bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    inline int daysInMonth(int year, int month) {
+        static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return days[month - 1] + (month == 2 && isLeapYear(year));
+    }
+
+    /**
+     * @brief 公历日期到1970-01-01的天数
+     */
+    qint64 daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const qint64 era = (year >= 0 ? year : year - 399) / 400;
+        const qint64 yearOfEra = year - era * 400;
+        const qint64 dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const qint64 dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    inline qint64 floorDiv(qint64 value, qint64 divisor) {
+        qint64 quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+
+    /**
+     * @brief 通过 Qt 计算某个本地时刻（以本地秒数表示）的UTC偏移
+     */
+    int qtOffsetAtLocalSecs(qint64 localSecs) {
+        qint64 days = floorDiv(localSecs, kSecsPerDay);
+        qint64 secsOfDay = localSecs - days * kSecsPerDay;
+        QDateTime dateTime(QDate::fromJulianDay(days + kUnixEpochJulianDay),
+                           QTime::fromMSecsSinceStartOfDay(static_cast<int>(secsOfDay * 1000)));
+        return dateTime.isValid() ? dateTime.offsetFromUtc() : kIrregularOffset;
+    }
+
+    std::atomic<int> g_offsetCacheGeneration{0};
+
+    /**
+     * @brief 每个线程各自的时区偏移表：本地小时 -> UTC偏移
+     *
+     * 前后一小时内偏移不变的小时才会被缓存为固定偏移，
+     * 夏令时切换附近的小时标记为不规则，由 Qt 处理。
+     */
+    struct OffsetCache {
+        int generation = -1;
+        QHash<qint64, int> offsets;
+
+        int offsetForHour(qint64 hour) {
+            int current = g_offsetCacheGeneration.load(std::memory_order_relaxed);
+            if (generation != current) {
+                offsets.clear();
+                generation = current;
+            }
+
+            auto it = offsets.constFind(hour);
+            if (it != offsets.constEnd()) {
+                return it.value();
+            }
+
+            int before = qtOffsetAtLocalSecs((hour - 1) * kSecsPerHour);
+            int after = qtOffsetAtLocalSecs((hour + 2) * kSecsPerHour - 1);
+            int offset = (before == after) ? before : kIrregularOffset;
+            offsets.insert(hour, offset);
+            return offset;
+        }
+    };
+
+    OffsetCache &offsetCache() {
+        thread_local OffsetCache cache;
+        return cache;
+    }
+
+    inline void putDigits2(char16_t *&out, int value) {
+        *out++ = char16_t(u'0' + value / 10);
+        *out++ = char16_t(u'0' + value % 10);
+    }
+
+    inline void putDigits4(char16_t *&out, int value) {
+        putDigits2(out, value / 100);
+        putDigits2(out, value % 100);
+    }
+
+    inline bool hasFastLayout(const QDateTime &dateTime) {
+        if (!dateTime.isValid() || dateTime.timeSpec() != Qt::LocalTime) {
+            return false;
+        }
+        int year = dateTime.date().year();
+        return year >= 1 && year <= 9999;
+    }
+}
+
+bool IsoTimestamp::parseFields(QStringView text, Fields &fields) {
+    if (text.size() != kIsoLength) {
+        return false;
+    }
+
+    // 收窄为ASCII字节，非ASCII字符记为错误
+    char bytes[kWordCount * 8] = {};
+    char16_t nonAscii = 0;
+    const QChar *chars = text.data();
+    for (int i = 0; i < kIsoLength; ++i) {
+        char16_t c = chars[i].unicode();
+        nonAscii |= c & 0xFF80;
+        bytes[i] = static_cast<char>(c);
+    }
+
+    // 按64位字同时校验所有数字位与分隔符
+    const LayoutWords &layout = layoutWords();
+    uint64_t mismatch = nonAscii;
+    for (int w = 0; w < kWordCount; ++w) {
+        uint64_t word;
+        std::memcpy(&word, bytes + w * 8, sizeof(word));
+        const uint64_t digitMask = layout.digits[w];
+        const uint64_t zeros = kAsciiZeros & digitMask;
+        // 数字字节的高半字节为3，且加6后不进位到4
+        mismatch |= (word & kHighNibbles & digitMask) ^ zeros;
+        mismatch |= ((word + kSixes) & kHighNibbles & digitMask) ^ zeros;
+        mismatch |= (word & ~digitMask) ^ layout.separators[w];
+    }
+    if (mismatch != 0) {
+        return false;
+    }
+
+    fields.year = twoDigits(bytes, 0) * 100 + twoDigits(bytes, 2);
+    fields.month = twoDigits(bytes, 5);
+    fields.day = twoDigits(bytes, 8);
+    fields.hour = twoDigits(bytes, 11);
+    fields.minute = twoDigits(bytes, 14);
+    fields.second = twoDigits(bytes, 17);
+
+    bool inRange = (fields.year >= 1)
+                 & (fields.month >= 1) & (fields.month <= 12)
+                 & (fields.hour <= 23) & (fields.minute <= 59) & (fields.second <= 59);
+    return inRange && fields.day >= 1 && fields.day <= daysInMonth(fields.year, fields.month);
+}
+
+QDateTime IsoTimestamp::fromLocalFields(const Fields &fields) {
+    qint64 localSecs = daysFromCivil(fields.year, fields.month, fields.day) * kSecsPerDay
+                       + fields.hour * kSecsPerHour + fields.minute * 60 + fields.second;
+
+    int offset = offsetCache().offsetForHour(floorDiv(localSecs, kSecsPerHour));
+    if (offset == kIrregularOffset) {
+        return QDateTime();
+    }
+    return QDateTime::fromSecsSinceEpoch(localSecs - offset);
+}
+
+QDateTime IsoTimestamp::parse(QStringView text) {
+    Fields fields;
+    if (parseFields(text, fields)) {
+        QDateTime dateTime = fromLocalFields(fields);
+        if (dateTime.isValid()) {
+            return dateTime;
+        }
+    }
+    // 其他ISO变体（毫秒、时区后缀、仅日期等）及夏令时切换附近的时间交给 Qt
+    return QDateTime::fromString(text.toString(), Qt::ISODate);
+}
+
+QDateTime IsoTimestamp::fromLegacyHour(const QDate &today, int startHour) {
+    if (today.isValid() && startHour >= 0 && startHour <= 23) {
+        Fields fields;
+        today.getDate(&fields.year, &fields.month, &fields.day);
+        fields.hour = startHour;
+        fields.minute = 0;
+        fields.second = 0;
+        QDateTime dateTime = fromLocalFields(fields);
+        if (dateTime.isValid()) {
+            return dateTime;
+        }
+    }
+    return QDateTime(today, QTime(startHour, 0));
+}
+
+QString IsoTimestamp::format(const QDateTime &dateTime) {
+    if (!hasFastLayout(dateTime)) {
+        return dateTime.toString(Qt::ISODate);
+    }
+
+    int year, month, day;
+    dateTime.date().getDate(&year, &month, &day);
+    QTime time = dateTime.time();
+
+    char16_t buffer[kIsoLength];
+    char16_t *out = buffer;
+    putDigits4(out, year);
+    *out++ = u'-';
+    putDigits2(out, month);
+    *out++ = u'-';
+    putDigits2(out, day);
+    *out++ = u'T';
+    putDigits2(out, time.hour());
+    *out++ = u':';
+    putDigits2(out, time.minute());
+    *out++ = u':';
+    putDigits2(out, time.second());
+
+    return QString(reinterpret_cast<const QChar *>(buffer), kIsoLength);
+}
+
+int IsoTimestamp::writeDisplay(char16_t *out, const QDateTime &dateTime, DisplayLayout layout) {
+    char16_t *begin = out;
+    int year, month, day;
+    dateTime.date().getDate(&year, &month, &day);
+    QTime time = dateTime.time();
+
+    if (layout == DateTimeMinutes) {
+        putDigits4(out, year);
+        *out++ = u'-';
+    }
+    if (layout != Minutes) {
+        putDigits2(out, month);
+        *out++ = u'-';
+        putDigits2(out, day);
+        *out++ = u' ';
+    }
+    putDigits2(out, time.hour());
+    *out++ = u':';
+    putDigits2(out, time.minute());
+
+    return static_cast<int>(out - begin);
+}
+
+QString IsoTimestamp::formatDisplay(const QDateTime &dateTime, DisplayLayout layout) {
+    if (!hasFastLayout(dateTime)) {
+        switch (layout) {
+            case DateTimeMinutes: return dateTime.toString("yyyy-MM-dd hh:mm");
+            case MonthDayMinutes: return dateTime.toString("MM-dd hh:mm");
+            case Minutes: return dateTime.toString("hh:mm");
+        }
+    }
+
+    char16_t buffer[16];
+    int length = writeDisplay(buffer, dateTime, layout);
+    return QString(reinterpret_cast<const QChar *>(buffer), length);
+}
+
+QString IsoTimestamp::formatRange(const QDateTime &start, const QDateTime &end, DisplayLayout layout) {
+    if (!hasFastLayout(start) || !hasFastLayout(end)) {
+        return QString("%1 - %2")
+                .arg(formatDisplay(start, layout))
+                .arg(formatDisplay(end, layout));
+    }
+
+    // 一次写入整个范围，只分配一次字符串
+    char16_t buffer[40];
+    char16_t *out = buffer;
+    out += writeDisplay(out, start, layout);
+    *out++ = u' ';
+    *out++ = u'-';
+    *out++ = u' ';
+    out += writeDisplay(out, end, layout);
+    return QString(reinterpret_cast<const QChar *>(buffer), static_cast<int>(out - buffer));
+}
+
+void IsoTimestamp::clearOffsetCache() {
+    g_offsetCacheGeneration.fetch_add(1, std::memory_order_relaxed);
+}
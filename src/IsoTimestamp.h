@@ -0,0 +1,79 @@
+#ifndef ISOTIMESTAMP_H
+#define ISOTIMESTAMP_H
+
+#include <QString>
+#include <QStringView>
+#include <QDateTime>
+
+/**
+ * @brief 固定格式时间戳的快速解析与格式化
+ *
+ * 针对 status.json 中使用的 yyyy-MM-ddThh:mm:ss 格式做专门处理，
+ * 解析过程不分配内存；本地时间的换算通过缓存的时区偏移表完成。
+ * 不符合固定格式的输入回退到 QDateTime，保证结果与 Qt 完全一致。
+ */
+class IsoTimestamp {
+public:
+    /**
+     * @brief 显示用的时间格式
+     */
+    enum DisplayLayout {
+        DateTimeMinutes, // yyyy-MM-dd hh:mm
+        MonthDayMinutes, // MM-dd hh:mm
+        Minutes          // hh:mm
+    };
+
+    /**
+     * @brief 解析出的本地时间字段
+     */
+    struct Fields {
+        int year;
+        int month;
+        int day;
+        int hour;
+        int minute;
+        int second;
+    };
+
+    /**
+     * @brief 解析固定格式 yyyy-MM-ddThh:mm:ss，格式或取值不合法时返回false
+     */
+    static bool parseFields(QStringView text, Fields &fields);
+
+    /**
+     * @brief 等价于 QDateTime::fromString(text, Qt::ISODate)
+     */
+    static QDateTime parse(QStringView text);
+
+    /**
+     * @brief 旧格式（仅小时）的起始时间，等价于 QDateTime(today, QTime(startHour, 0))
+     */
+    static QDateTime fromLegacyHour(const QDate &today, int startHour);
+
+    /**
+     * @brief 等价于 dateTime.toString(Qt::ISODate)
+     */
+    static QString format(const QDateTime &dateTime);
+
+    /**
+     * @brief 等价于按对应格式调用 dateTime.toString(...)
+     */
+    static QString formatDisplay(const QDateTime &dateTime, DisplayLayout layout);
+
+    /**
+     * @brief 生成 "起始 - 结束" 形式的时间范围字符串
+     */
+    static QString formatRange(const QDateTime &start, const QDateTime &end, DisplayLayout layout);
+
+    /**
+     * @brief 使时区偏移缓存失效（系统时区变化后调用）
+     */
+    static void clearOffsetCache();
+
+private:
+    static QDateTime fromLocalFields(const Fields &fields);
+
+    static int writeDisplay(char16_t *out, const QDateTime &dateTime, DisplayLayout layout);
+};
+
+#endif // ISOTIMESTAMP_H
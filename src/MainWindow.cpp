@@ -1,5 +1,8 @@
 #include "MainWindow.h"
 #include "ManageDialog.h"
+#include "StatusImporter.h"
+#include <QBuffer>
+#include <QDebug>
 #include <QScreen>
 #include <QGuiApplication>
 #include <QVBoxLayout>
@@ -13,6 +16,8 @@
 MainWindow::MainWindow(StatusManager *manager, QWidget *parent)
     : QWidget(parent, Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::Tool)
       , m_statusManager(manager)
+      , m_manageDialog(nullptr)
+      , m_activeCount(-1)
       , m_dragging(false)
       , m_expanded(false) {
     setupUI();
@@ -22,10 +27,13 @@ MainWindow::MainWindow(StatusManager *manager, QWidget *parent)
     connect(m_statusManager, &StatusManager::statusesChanged,
             this, &MainWindow::onStatusesChanged);
 
-    // 设置定时器，每30秒刷新一次
+    // 状态开始、结束时由事件调度刷新；定时器只作兜底，每30秒刷新一次
+    connect(m_statusManager, &StatusManager::statusStarted, this, &MainWindow::refreshDisplay);
+    connect(m_statusManager, &StatusManager::statusEnded, this, &MainWindow::refreshDisplay);
+    connect(m_statusManager, &StatusManager::statusReminder, this, &MainWindow::showReminder);
     m_refreshTimer = new QTimer(this);
     connect(m_refreshTimer, &QTimer::timeout, this, &MainWindow::refreshDisplay);
-    m_refreshTimer->start(1000);
+    m_refreshTimer->start(30000);
 
     // 初始显示
     refreshDisplay();
@@ -139,23 +147,20 @@ void MainWindow::savePosition() {
     settings.setValue("windowPosition", pos());
 }
 
-bool operator==(const QVector<StatusData> &lhs, const QVector<StatusData> &rhs) {
-    if (lhs.size() != rhs.size()) return false;
-    for (int i = 0; i < lhs.size(); ++i) {
-        if (!(lhs[i] == rhs[i])) return false;
-    }
-    return true;
-}
-
 void MainWindow::refreshDisplay() {
-    QVector<StatusData> activeStatuses = m_statusManager->getActiveStatuses();
-    if (m_statusesTemp == activeStatuses) {
+    // 收起时只取排名前几位；排名由管理器增量维护，不扫描全部状态
+    qsizetype activeCount = 0;
+    QVector<StatusData> shownStatuses =
+        m_statusManager->topActive(m_expanded ? -1 : DEFAULT_SHOW_COUNT, &activeCount);
+    if (shownStatuses == m_statusesTemp && activeCount == m_activeCount) {
         return;
-    } else {
-        clearIcons();
-        m_statusesTemp = activeStatuses;
     }
-    if (activeStatuses.isEmpty()) {
+
+    clearIcons();
+    m_statusesTemp = shownStatuses;
+    m_activeCount = activeCount;
+
+    if (m_statusesTemp.isEmpty()) {
         // 显示空状态标签
         m_iconLayout->addWidget(m_emptyLabel, 0, 0);
         m_emptyLabel->show();
@@ -163,19 +168,9 @@ void MainWindow::refreshDisplay() {
     } else {
         m_emptyLabel->hide();
 
-        // 确定要显示的状态数量
-        int displayCount = activeStatuses.size();
-        bool showExpandButton = false;
-
-        if (!m_expanded && activeStatuses.size() > DEFAULT_SHOW_COUNT) {
-            displayCount = DEFAULT_SHOW_COUNT;
-            showExpandButton = true;
-        }
-
         // 显示图标
         int row = 0, col = 0;
-        for (int i = 0; i < displayCount; ++i) {
-            const StatusData &status = activeStatuses[i];
+        for (const StatusData &status : std::as_const(m_statusesTemp)) {
             createIconLabel(status);
 
             QLabel *label = m_iconLabels.last();
@@ -189,10 +184,10 @@ void MainWindow::refreshDisplay() {
         }
 
         // 显示或隐藏展开按钮
-        if (showExpandButton) {
-            m_expandButton->setText(QString("▼ 展开 (%1 更多)").arg(activeStatuses.size() - DEFAULT_SHOW_COUNT));
+        if (!m_expanded && m_activeCount > DEFAULT_SHOW_COUNT) {
+            m_expandButton->setText(QString("▼ 展开 (%1 更多)").arg(m_activeCount - DEFAULT_SHOW_COUNT));
             m_expandButton->show();
-        } else if (m_expanded && activeStatuses.size() > DEFAULT_SHOW_COUNT) {
+        } else if (m_expanded && m_activeCount > DEFAULT_SHOW_COUNT) {
             m_expandButton->setText("▲ 收起");
             m_expandButton->show();
         } else {
@@ -257,8 +252,58 @@ void MainWindow::onStatusesChanged() {
 }
 
 void MainWindow::openManageDialog() {
+    if (m_manageDialog) {
+        m_manageDialog->raise();
+        m_manageDialog->activateWindow();
+        return;
+    }
     ManageDialog dialog(m_statusManager, this);
+    m_manageDialog = &dialog;
     dialog.exec();
+    m_manageDialog = nullptr;
+}
+
+void MainWindow::handleArguments(const QStringList &arguments) {
+    bool bringToFront = arguments.isEmpty();
+    QVector<StatusData> added;
+
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QString &argument = arguments[i];
+        if (argument == "--show") {
+            bringToFront = true;
+        } else if (argument == "--manage") {
+            // 管理界面是模态的，不在转发请求的处理过程中打开
+            QMetaObject::invokeMethod(this, &MainWindow::openManageDialog, Qt::QueuedConnection);
+        } else if (argument == "--reload") {
+            m_statusManager->loadAllSourcesAsync();
+        } else if (argument == "--add" && i + 1 < arguments.size()) {
+            // 与批量导入的CSV格式相同
+            QByteArray line = arguments[++i].toUtf8();
+            QBuffer buffer(&line);
+            buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+            QVector<StatusData> parsed = StatusImporter::parse(&buffer, StatusImporter::Csv);
+            if (parsed.isEmpty()) {
+                qWarning() << "无法解析的状态:" << arguments[i];
+            }
+            added += parsed;
+        } else if (argument != "--startup-bench") {
+            qWarning() << "未知参数:" << argument;
+        }
+    }
+
+    if (!added.isEmpty()) {
+        m_statusManager->addStatuses(added);
+    }
+    if (bringToFront) {
+        show();
+        raise();
+        activateWindow();
+    }
+}
+
+void MainWindow::showReminder(const StatusData &status, int minutesBefore) {
+    QString title = QString("%1 分钟后开始").arg(minutesBefore);
+    m_trayIcon->showMessage(title, status.icon + " " + status.description, QSystemTrayIcon::Information);
 }
 
 void MainWindow::trayIconActivated(QSystemTrayIcon::ActivationReason reason) {
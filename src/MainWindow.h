@@ -10,6 +10,8 @@
 #include <QPushButton>
 #include "StatusManager.h"
 
+class ManageDialog;
+
 /**
  * @brief 主显示窗口，显示当前有效的状态图标
  */
@@ -21,6 +23,15 @@ public:
 
     ~MainWindow();
 
+public slots:
+    /**
+     * @brief 处理命令行参数（本实例启动时的参数或其他实例转发的参数）
+     *
+     * --show 显示主窗口（没有参数时默认）；--manage 打开管理界面；
+     * --add "图标,描述,起始时间,持续小时数[,优先级]" 添加状态（可重复）；--reload 重新加载所有数据源。
+     */
+    void handleArguments(const QStringList &arguments);
+
 protected:
     void mousePressEvent(QMouseEvent *event) override;
 
@@ -35,6 +46,11 @@ private slots:
 
     void onStatusesChanged();
 
+    /**
+     * @brief 状态开始前的桌面通知
+     */
+    void showReminder(const StatusData &status, int minutesBefore);
+
     void openManageDialog();
 
     void trayIconActivated(QSystemTrayIcon::ActivationReason reason);
@@ -61,9 +77,11 @@ private:
     QVector<QLabel *> m_iconLabels;
     QLabel *m_emptyLabel;
     QPushButton *m_expandButton;
+    ManageDialog *m_manageDialog; // 打开中的管理界面
 
-    // 缓存状态数据
-    QVector<StatusData> m_statusesTemp = {StatusData()};
+    // 缓存当前显示的状态（按排名）及有效状态总数
+    QVector<StatusData> m_statusesTemp;
+    qsizetype m_activeCount;
 
 
     // 系统托盘
@@ -1,4 +1,7 @@
 #include "ManageDialog.h"
+#include "IsoTimestamp.h"
+#include "TimelineWidget.h"
+#include "StatusImporter.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -8,6 +11,7 @@
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QScreen>
+#include <QFileDialog>
 
 ManageDialog::  ManageDialog(StatusManager *manager, QWidget *parent)
     : QDialog(parent)
@@ -42,6 +46,7 @@ void ManageDialog::setupUI() {
     
     createAddTab();
     createViewTabs();
+    createTimelineTab();
     
     mainLayout->addWidget(m_mainTabs);
     
@@ -86,6 +91,12 @@ void ManageDialog::createAddTab() {
     m_durationSpin->setSuffix(" 小时");
     formLayout->addRow("持续时长:", m_durationSpin);
 
+    m_prioritySpin = new QSpinBox;
+    m_prioritySpin->setRange(-99, 99);
+    m_prioritySpin->setValue(0);
+    m_prioritySpin->setToolTip("数值越大越重要，收起时优先显示");
+    formLayout->addRow("优先级:", m_prioritySpin);
+
     layout->addWidget(inputGroup);
 
     // 添加按钮
@@ -94,6 +105,37 @@ void ManageDialog::createAddTab() {
     connect(m_addButton, &QPushButton::clicked, this, &ManageDialog::addStatus);
     layout->addWidget(m_addButton);
 
+    // 批量导入
+    QGroupBox *importGroup = new QGroupBox("批量导入");
+    QHBoxLayout *importLayout = new QHBoxLayout(importGroup);
+
+    m_importButton = new QPushButton("从 CSV / iCalendar 导入...");
+    connect(m_importButton, &QPushButton::clicked, this, &ManageDialog::importStatuses);
+    importLayout->addWidget(m_importButton);
+
+    m_importProgress = new QProgressBar;
+    m_importProgress->setRange(0, 1000);
+    m_importProgress->setTextVisible(false);
+    m_importProgress->hide();
+    importLayout->addWidget(m_importProgress, 1);
+
+    m_cancelImportButton = new QPushButton("取消");
+    m_cancelImportButton->hide();
+    importLayout->addWidget(m_cancelImportButton);
+
+    layout->addWidget(importGroup);
+
+    m_importer = new StatusImporter(m_statusManager, this);
+    connect(m_importer, &StatusImporter::progressChanged, m_importProgress, &QProgressBar::setValue);
+    connect(m_importer, &StatusImporter::finished, this, &ManageDialog::onImportFinished);
+    connect(m_importer, &StatusImporter::failed, this, &ManageDialog::onImportFailed);
+    connect(m_cancelImportButton, &QPushButton::clicked, this, [this]() {
+        m_importer->cancel();
+        m_importProgress->hide();
+        m_cancelImportButton->hide();
+        m_importButton->setEnabled(true);
+    });
+
     // 说明文本
     QLabel *helpLabel = new QLabel(
         "<b>使用说明：</b><br>"
@@ -102,7 +144,8 @@ void ManageDialog::createAddTab() {
         "• Windows快捷键：Win + . (句号) 打开emoji面板<br>"
         "• 起始时间：点击可选择年月日和具体时间<br>"
         "• 持续时长：状态持续的小时数（1-168小时）<br>"
-        "• 示例：2026-02-11 09:00 开始，持续8小时 = 09:00-17:00"
+        "• 示例：2026-02-11 09:00 开始，持续8小时 = 09:00-17:00<br>"
+        "• 批量导入：CSV 每行为 图标,描述,起始时间,持续小时数；也支持 .ics 日历文件，重复的状态会自动跳过"
     );
     helpLabel->setWordWrap(true);
     helpLabel->setStyleSheet("QLabel { padding: 15px; background-color: #f0f0f0; border-radius: 5px; }");
@@ -119,8 +162,8 @@ void ManageDialog::createViewTabs() {
     QVBoxLayout *allLayout = new QVBoxLayout(allWidget);
 
     m_allTable = new QTableWidget;
-    m_allTable->setColumnCount(5);
-    m_allTable->setHorizontalHeaderLabels({"图标", "描述", "起始时间", "持续时长", "时间范围"});
+    m_allTable->setColumnCount(6);
+    m_allTable->setHorizontalHeaderLabels({"图标", "描述", "起始时间", "持续时长", "优先级", "时间范围"});
     m_allTable->horizontalHeader()->setStretchLastSection(true);
     m_allTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_allTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -137,8 +180,8 @@ void ManageDialog::createViewTabs() {
     QVBoxLayout *currentLayout = new QVBoxLayout(currentWidget);
 
     m_currentTable = new QTableWidget;
-    m_currentTable->setColumnCount(5);
-    m_currentTable->setHorizontalHeaderLabels({"图标", "描述", "起始时间", "持续时长", "时间范围"});
+    m_currentTable->setColumnCount(6);
+    m_currentTable->setHorizontalHeaderLabels({"图标", "描述", "起始时间", "持续时长", "优先级", "时间范围"});
     m_currentTable->horizontalHeader()->setStretchLastSection(true);
     m_currentTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_currentTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -151,8 +194,8 @@ void ManageDialog::createViewTabs() {
     QVBoxLayout *expiredLayout = new QVBoxLayout(expiredWidget);
 
     m_expiredTable = new QTableWidget;
-    m_expiredTable->setColumnCount(5);
-    m_expiredTable->setHorizontalHeaderLabels({"图标", "描述", "起始时间", "持续时长", "时间范围"});
+    m_expiredTable->setColumnCount(6);
+    m_expiredTable->setHorizontalHeaderLabels({"图标", "描述", "起始时间", "持续时长", "优先级", "时间范围"});
     m_expiredTable->horizontalHeader()->setStretchLastSection(true);
     m_expiredTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_expiredTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -161,6 +204,27 @@ void ManageDialog::createViewTabs() {
     m_mainTabs->addTab(expiredWidget, "过期状态");
 }
 
+void ManageDialog::createTimelineTab() {
+    QWidget *timelineWidget = new QWidget;
+    QVBoxLayout *timelineLayout = new QVBoxLayout(timelineWidget);
+
+    m_timeline = new TimelineWidget(m_statusManager);
+    timelineLayout->addWidget(m_timeline);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout;
+    QLabel *hintLabel = new QLabel("滚轮缩放，拖动平移，Shift + 滚轮上下滚动，双击显示全部");
+    hintLabel->setStyleSheet("QLabel { color: #666666; }");
+    buttonLayout->addWidget(hintLabel);
+    buttonLayout->addStretch();
+
+    QPushButton *fitButton = new QPushButton("显示全部");
+    connect(fitButton, &QPushButton::clicked, m_timeline, &TimelineWidget::fitAll);
+    buttonLayout->addWidget(fitButton);
+    timelineLayout->addLayout(buttonLayout);
+
+    m_mainTabs->addTab(timelineWidget, "时间线");
+}
+
 void ManageDialog::addStatus() {
     if (m_iconEdit->text().trimmed().isEmpty()) {
         QMessageBox::warning(this, "输入错误", "请输入图标！");
@@ -177,6 +241,7 @@ void ManageDialog::addStatus() {
     status.description = m_descEdit->text().trimmed();
     status.startDateTime = m_startDateTimeEdit->dateTime();
     status.durationHours = m_durationSpin->value();
+    status.priority = m_prioritySpin->value();
 
     m_statusManager->addStatus(status);
 
@@ -185,6 +250,7 @@ void ManageDialog::addStatus() {
     m_descEdit->clear();
     m_startDateTimeEdit->setDateTime(QDateTime::currentDateTime());
     m_durationSpin->setValue(8);
+    m_prioritySpin->setValue(0);
 
     QMessageBox::information(this, "成功", "状态已添加！");
 }
@@ -196,48 +262,97 @@ void ManageDialog::deleteStatus() {
         return;
     }
 
+    // 弹出对话框前取出唯一标识，确认期间列表发生变化也不会删错
+    const QUuid uid = m_allTable->item(currentRow, 0)->data(Qt::UserRole).toUuid();
+    QString provider = m_statusManager->providerOf(uid);
+    if (!provider.isEmpty()) {
+        QMessageBox::information(this, "无法删除",
+            QString("该状态由后台提供者“%1”生成，请在其数据来源中删除。").arg(provider));
+        return;
+    }
+
     QMessageBox::StandardButton reply = QMessageBox::question(
         this, "确认删除", "确定要删除选中的状态吗？",
         QMessageBox::Yes | QMessageBox::No
     );
 
     if (reply == QMessageBox::Yes) {
-        m_statusManager->removeStatus(currentRow);
+        m_statusManager->removeStatus(uid);
+    }
+}
+
+void ManageDialog::importStatuses() {
+    QString filePath = QFileDialog::getOpenFileName(
+        this, "选择导入文件", QString(),
+        "状态文件 (*.csv *.ics);;CSV 文件 (*.csv);;iCalendar 文件 (*.ics)");
+    if (filePath.isEmpty()) {
+        return;
     }
+
+    m_importButton->setEnabled(false);
+    m_importProgress->setValue(0);
+    m_importProgress->show();
+    m_cancelImportButton->show();
+    m_importer->start(filePath);
 }
 
-void ManageDialog::populateTable(QTableWidget *table, const QVector<StatusData> &statuses) {
-    table->setRowCount(statuses.size());
+void ManageDialog::onImportFinished(int imported, int duplicates, int invalid) {
+    m_importProgress->hide();
+    m_cancelImportButton->hide();
+    m_importButton->setEnabled(true);
+
+    QMessageBox::information(this, "导入完成",
+        QString("新增 %1 个状态，跳过 %2 个重复记录，%3 条记录无法解析。")
+            .arg(imported).arg(duplicates).arg(invalid));
+}
 
-    for (int i = 0; i < statuses.size(); ++i) {
-        const StatusData &status = statuses[i];
+void ManageDialog::onImportFailed(const QString &message) {
+    m_importProgress->hide();
+    m_cancelImportButton->hide();
+    m_importButton->setEnabled(true);
+
+    QMessageBox::warning(this, "导入失败", message);
+}
 
+template <typename StatusRange>
+void ManageDialog::populateTable(QTableWidget *table, StatusRange &&statuses) {
+    // 视图只遍历一遍：行数按需倍增，结束后截到实际行数
+    table->setRowCount(0);
+    int i = 0;
+    for (const StatusData &status : statuses) {
+        if (i == table->rowCount()) {
+            table->setRowCount(qMax(64, i * 2));
+        }
         table->setItem(i, 0, new QTableWidgetItem(status.icon));
         table->setItem(i, 1, new QTableWidgetItem(status.description));
-        table->setItem(i, 2, new QTableWidgetItem(status.startDateTime.toString("yyyy-MM-dd hh:mm")));
+        table->setItem(i, 2, new QTableWidgetItem(IsoTimestamp::formatDisplay(status.startDateTime, IsoTimestamp::DateTimeMinutes)));
         table->setItem(i, 3, new QTableWidgetItem(QString::number(status.durationHours) + " 小时"));
-        table->setItem(i, 4, new QTableWidgetItem(status.getTimeRange()));
+        table->setItem(i, 4, new QTableWidgetItem(QString::number(status.priority)));
+        table->setItem(i, 5, new QTableWidgetItem(status.getTimeRange()));
         
         // 设置图标列的字体大小
         QFont iconFont = table->item(i, 0)->font();
         iconFont.setPointSize(20);
         table->item(i, 0)->setFont(iconFont);
         table->item(i, 0)->setTextAlignment(Qt::AlignCenter);
+        table->item(i, 0)->setData(Qt::UserRole, status.uid);
+        ++i;
     }
+    table->setRowCount(i);
     
     table->resizeColumnsToContents();
 }
 
 void ManageDialog::refreshAllTable() {
-    populateTable(m_allTable, m_statusManager->getAllStatuses());
+    populateTable(m_allTable, m_statusManager->query().view());
 }
 
 void ManageDialog::refreshCurrentTable() {
-    populateTable(m_currentTable, m_statusManager->getActiveStatuses());
+    populateTable(m_currentTable, m_statusManager->query().activeAt(QDateTime::currentDateTime()).view());
 }
 
 void ManageDialog::refreshExpiredTable() {
-    populateTable(m_expiredTable, m_statusManager->getExpiredStatuses());
+    populateTable(m_expiredTable, m_statusManager->query().expiredAt(QDateTime::currentDateTime()).view());
 }
 
 void ManageDialog::onTabChanged(int index) {
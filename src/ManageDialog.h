@@ -8,8 +8,12 @@
 #include <QSpinBox>
 #include <QPushButton>
 #include <QDateTimeEdit>
+#include <QProgressBar>
 #include "StatusManager.h"
 
+class TimelineWidget;
+class StatusImporter;
+
 /**
  * @brief 状态管理对话框，用于添加和查看状态
  */
@@ -22,6 +26,9 @@ public:
 private slots:
     void addStatus();
     void deleteStatus();
+    void importStatuses();
+    void onImportFinished(int imported, int duplicates, int invalid);
+    void onImportFailed(const QString &message);
     void refreshAllTable();
     void refreshCurrentTable();
     void refreshExpiredTable();
@@ -31,7 +38,9 @@ private:
     void setupUI();
     void createAddTab();
     void createViewTabs();
-    void populateTable(QTableWidget *table, const QVector<StatusData> &statuses);
+    void createTimelineTab();
+    template <typename StatusRange>
+    void populateTable(QTableWidget *table, StatusRange &&statuses);
 
     StatusManager *m_statusManager;
 
@@ -40,13 +49,23 @@ private:
     QLineEdit *m_descEdit;
     QDateTimeEdit *m_startDateTimeEdit;  // 改为日期时间选择器
     QSpinBox *m_durationSpin;
+    QSpinBox *m_prioritySpin;
     QPushButton *m_addButton;
 
+    // 批量导入
+    StatusImporter *m_importer;
+    QPushButton *m_importButton;
+    QPushButton *m_cancelImportButton;
+    QProgressBar *m_importProgress;
+
     // 查看状态选项卡
     QTabWidget *m_mainTabs;
     QTableWidget *m_allTable;
     QTableWidget *m_currentTable;
     QTableWidget *m_expiredTable;
+
+    // 时间线选项卡
+    TimelineWidget *m_timeline;
 };
 
 #endif // MANAGEDIALOG_H
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "ProviderScheduler.h"
+#include "StatusProviders.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSettings>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief 从列表中删除一个与 status 内容（含优先级）相同的元素
+     */
+    bool takeMatching(QVector<StatusData> &list, const StatusData &status) {
+        auto it = std::find(list.begin(), list.end(), status);
+        while (it != list.end() && it->priority != status.priority) {
+            it = std::find(it + 1, list.end(), status);
+        }
+        if (it == list.end()) {
+            return false;
+        }
+        list.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief 把后一次增量合并到尚未提交的增量中，先增后删的状态相互抵消
+     */
+    void mergeDiff(ProviderDiff &into, const ProviderDiff &next) {
+        for (const StatusData &status : next.removed) {
+            if (!takeMatching(into.added, status)) {
+                into.removed.append(status);
+            }
+        }
+        for (const StatusData &status : next.added) {
+            if (!takeMatching(into.removed, status)) {
+                into.added.append(status);
+            }
+        }
+    }
+}
+
+ProviderScheduler::ProviderScheduler(StatusManager *manager, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager) {
+    // 线程池不设父对象：退出时若有提供者仍挂起，不等待它结束（见析构函数）
+    m_pool = new QThreadPool;
+    m_pool->setMaxThreadCount(2);
+
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &ProviderScheduler::onPathChanged);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &ProviderScheduler::onPathChanged);
+
+    m_batchTimer = new QTimer(this);
+    m_batchTimer->setSingleShot(true);
+    m_batchTimer->setInterval(BATCH_WINDOW);
+    connect(m_batchTimer, &QTimer::timeout, this, &ProviderScheduler::flushDiffs);
+}
+
+ProviderScheduler::~ProviderScheduler() {
+    m_pool->clear();
+    if (m_pool->waitForDone(SHUTDOWN_TIMEOUT)) {
+        delete m_pool;
+    } else {
+        // 仍有提供者挂起：销毁线程池会一直等待，进程即将退出，直接放弃
+        qWarning() << "后台状态提供者未在退出前结束";
+    }
+}
+
+void ProviderScheduler::loadFromSettings() {
+    QSettings settings("StatusApp", "StatusDisplayApp");
+    setMaxThreadCount(settings.value("providerThreads", 2).toInt());
+
+    int count = settings.beginReadArray("providers");
+    for (int i = 0; i < count; ++i) {
+        settings.setArrayIndex(i);
+        QString type = settings.value("type").toString();
+        QString name = settings.value("name", QString("provider%1").arg(i + 1)).toString();
+
+        std::shared_ptr<StatusProvider> provider;
+        if (type == "calendar") {
+            provider = std::make_shared<CalendarFileProvider>(name, settings.value("path").toString());
+        } else if (type == "command") {
+            provider = std::make_shared<CommandProvider>(name, settings.value("program").toString(),
+                                                         settings.value("arguments").toStringList());
+        } else if (type == "directory") {
+            provider = std::make_shared<DirectoryProvider>(name, settings.value("path").toString());
+        } else {
+            qWarning() << "未知的状态提供者类型:" << type;
+            continue;
+        }
+
+        if (settings.contains("pollSeconds")) {
+            provider->setPollInterval(settings.value("pollSeconds").toInt() * 1000);
+        }
+        if (settings.contains("minimumSeconds")) {
+            provider->setMinimumInterval(settings.value("minimumSeconds").toInt() * 1000);
+        }
+        if (settings.contains("timeoutSeconds")) {
+            provider->setTimeout(settings.value("timeoutSeconds").toInt() * 1000);
+        }
+        addProvider(provider);
+    }
+    settings.endArray();
+}
+
+bool ProviderScheduler::addProvider(std::shared_ptr<StatusProvider> provider) {
+    if (!provider) {
+        return false;
+    }
+    for (const auto &slot : m_slots) {
+        if (slot->provider->name() == provider->name()) {
+            qWarning() << "状态提供者名称重复:" << provider->name();
+            return false;
+        }
+    }
+
+    const int index = static_cast<int>(m_slots.size());
+    auto slot = std::make_unique<ProviderSlot>();
+    slot->provider = provider;
+
+    slot->pollTimer = new QTimer(this);
+    connect(slot->pollTimer, &QTimer::timeout, this, [this, index]() { requestPoll(index); });
+    if (provider->pollInterval() > 0) {
+        slot->pollTimer->start(provider->pollInterval());
+    }
+
+    slot->delayTimer = new QTimer(this);
+    slot->delayTimer->setSingleShot(true);
+    connect(slot->delayTimer, &QTimer::timeout, this, [this, index]() { requestPoll(index); });
+
+    slot->timeoutTimer = new QTimer(this);
+    slot->timeoutTimer->setSingleShot(true);
+    connect(slot->timeoutTimer, &QTimer::timeout, this, [this, index]() { onPollTimeout(index); });
+
+    m_slots.push_back(std::move(slot));
+
+    for (const QString &path : provider->watchedPaths()) {
+        if (!m_watchedPaths.contains(path) && QFileInfo::exists(path)) {
+            m_watcher->addPath(path);
+        }
+        m_watchedPaths.insert(path, index);
+    }
+
+    requestPoll(index);
+    return true;
+}
+
+void ProviderScheduler::trigger(const QString &name) {
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        if (m_slots[i]->provider->name() == name) {
+            requestPoll(static_cast<int>(i));
+            return;
+        }
+    }
+}
+
+void ProviderScheduler::setMaxThreadCount(int count) {
+    m_pool->setMaxThreadCount(qMax(1, count));
+}
+
+void ProviderScheduler::requestPoll(int index) {
+    ProviderSlot &slot = *m_slots[index];
+
+    // 背压：进行中（包括已超时仍未返回）时只记一次待办
+    if (slot.running) {
+        slot.pending = true;
+        return;
+    }
+
+    // 限流：距上次开始不足最小间隔时推迟，期间的多次触发合并
+    if (slot.lastStarted.isValid()) {
+        qint64 wait = slot.provider->minimumInterval() - slot.lastStarted.elapsed();
+        if (wait > 0) {
+            if (!slot.delayTimer->isActive()) {
+                slot.delayTimer->start(static_cast<int>(wait));
+            }
+            return;
+        }
+    }
+
+    startPoll(index);
+}
+
+void ProviderScheduler::startPoll(int index) {
+    ProviderSlot &slot = *m_slots[index];
+    slot.running = true;
+    slot.pending = false;
+    slot.timedOut = false;
+    slot.lastStarted.start();
+
+    auto *watcher = new QFutureWatcher<PollOutcome>(this);
+    connect(watcher, &QFutureWatcher<PollOutcome>::finished, this, [this, index, watcher]() {
+        onPollFinished(index, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(m_pool, &ProviderScheduler::runPoll, slot.provider, slot.current));
+
+    slot.timeoutTimer->start(slot.provider->timeout());
+}
+
+ProviderScheduler::PollOutcome ProviderScheduler::runPoll(std::shared_ptr<StatusProvider> provider,
+                                                          QSet<PrioritizedStatus> previous) {
+    PollOutcome outcome;
+    ProviderResult result = provider->poll();
+    if (!result.ok) {
+        outcome.error = result.error;
+        return outcome;
+    }
+
+    // 与上一次结果比较，只提交增量
+    outcome.ok = true;
+    outcome.current.reserve(result.statuses.size());
+    // 只有优先级变化的状态也按删除旧的、新增新的提交
+    for (const StatusData &status : std::as_const(result.statuses)) {
+        const PrioritizedStatus entry{status};
+        if (outcome.current.contains(entry)) {
+            continue;
+        }
+        outcome.current.insert(entry);
+        if (!previous.remove(entry)) {
+            outcome.diff.added.append(status);
+        }
+    }
+    outcome.diff.removed.reserve(previous.size());
+    for (const PrioritizedStatus &entry : std::as_const(previous)) {
+        outcome.diff.removed.append(entry.status);
+    }
+    return outcome;
+}
+
+void ProviderScheduler::onPollTimeout(int index) {
+    ProviderSlot &slot = *m_slots[index];
+    if (!slot.running || slot.timedOut) {
+        return;
+    }
+
+    // 挂起的轮询继续占用一个线程，但临时扩容线程池，其他提供者照常运行
+    slot.timedOut = true;
+    m_pool->releaseThread();
+
+    QString message = "轮询超时";
+    qWarning() << "状态提供者" << slot.provider->name() << message;
+    emit providerFailed(slot.provider->name(), message);
+}
+
+void ProviderScheduler::onPollFinished(int index, const PollOutcome &outcome) {
+    ProviderSlot &slot = *m_slots[index];
+    slot.running = false;
+    slot.timeoutTimer->stop();
+    if (slot.timedOut) {
+        // 挂起的线程已返回，收回临时扩容
+        m_pool->reserveThread();
+        slot.timedOut = false;
+    }
+
+    if (!outcome.ok) {
+        qWarning() << "状态提供者" << slot.provider->name() << "失败:" << outcome.error;
+        emit providerFailed(slot.provider->name(), outcome.error);
+    } else {
+        slot.current = outcome.current;
+        if (!outcome.diff.added.isEmpty() || !outcome.diff.removed.isEmpty()) {
+            mergeDiff(m_pendingDiffs[slot.provider->name()], outcome.diff);
+            if (!m_batchTimer->isActive()) {
+                m_batchTimer->start();
+            }
+        }
+    }
+
+    if (slot.pending) {
+        requestPoll(index);
+    }
+}
+
+void ProviderScheduler::onPathChanged(const QString &path) {
+    // 文件被整体替换后监视会失效，重新添加
+    if (!m_watcher->files().contains(path) && !m_watcher->directories().contains(path)
+        && QFileInfo::exists(path)) {
+        m_watcher->addPath(path);
+    }
+
+    const QList<int> indexes = m_watchedPaths.values(path);
+    for (int index : indexes) {
+        requestPoll(index);
+    }
+}
+
+void ProviderScheduler::flushDiffs() {
+    if (m_pendingDiffs.isEmpty()) {
+        return;
+    }
+    QHash<QString, ProviderDiff> diffs;
+    diffs.swap(m_pendingDiffs);
+    m_statusManager->applyProviderDiffs(diffs);
+}
@@ -0,0 +1,116 @@
+#ifndef PROVIDERSCHEDULER_H
+#define PROVIDERSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <memory>
+#include <vector>
+#include "StatusManager.h"
+#include "StatusProvider.h"
+
+/**
+ * @brief 后台状态提供者的调度器
+ *
+ * 提供者在有界线程池中轮询（定期或由监视的文件、目录变化触发）：
+ * - 每个提供者同一时刻最多一次轮询，进行中再次触发只记为一次待办（背压）
+ * - 两次轮询开始之间至少间隔 minimumInterval（限流）
+ * - 轮询超时后归还线程池名额，挂起的提供者不影响其他提供者，也不阻塞界面
+ * - 结果在工作线程中与上一次结果比较，短时间内的增量合并后一次性提交给 StatusManager
+ *
+ * 配置（QSettings "StatusApp"/"StatusDisplayApp"，数组 providers）：
+ *     type       calendar（日历/CSV文件）、command（命令）、directory（目录）
+ *     name       名称，唯一
+ *     path       文件或目录路径
+ *     program    命令程序，arguments 为参数列表
+ *     pollSeconds / minimumSeconds / timeoutSeconds
+ * providerThreads 为线程池大小，默认2。
+ */
+class ProviderScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ProviderScheduler(StatusManager *manager, QObject *parent = nullptr);
+
+    ~ProviderScheduler();
+
+    /**
+     * @brief 按设置创建提供者并开始调度
+     */
+    void loadFromSettings();
+
+    /**
+     * @brief 添加提供者并立即轮询一次，名称重复时忽略
+     */
+    bool addProvider(std::shared_ptr<StatusProvider> provider);
+
+    /**
+     * @brief 请求轮询指定提供者（受限流和背压约束）
+     */
+    void trigger(const QString &name);
+
+    /**
+     * @brief 线程池大小
+     */
+    void setMaxThreadCount(int count);
+
+signals:
+    void providerFailed(const QString &name, const QString &message);
+
+private:
+    /**
+     * @brief 工作线程的轮询结果（已与上一次结果比较）
+     */
+    struct PollOutcome {
+        bool ok = false;
+        QString error;
+        QSet<PrioritizedStatus> current;
+        ProviderDiff diff;
+    };
+
+    /**
+     * @brief 每个提供者的调度状态
+     */
+    struct ProviderSlot {
+        std::shared_ptr<StatusProvider> provider;
+        QTimer *pollTimer = nullptr;    // 定期轮询
+        QTimer *delayTimer = nullptr;   // 限流期间推迟的轮询
+        QTimer *timeoutTimer = nullptr;
+        QElapsedTimer lastStarted;
+        bool running = false;
+        bool pending = false;           // 进行中又被触发
+        bool timedOut = false;          // 已超时并归还了线程池名额
+        QSet<PrioritizedStatus> current; // 已提交的结果
+    };
+
+    static PollOutcome runPoll(std::shared_ptr<StatusProvider> provider, QSet<PrioritizedStatus> previous);
+
+    void requestPoll(int index);
+
+    void startPoll(int index);
+
+    void onPollTimeout(int index);
+
+    void onPollFinished(int index, const PollOutcome &outcome);
+
+    void onPathChanged(const QString &path);
+
+    void flushDiffs();
+
+    StatusManager *m_statusManager;
+    QThreadPool *m_pool;
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_batchTimer;
+    std::vector<std::unique_ptr<ProviderSlot>> m_slots;
+    QMultiHash<QString, int> m_watchedPaths;
+    QHash<QString, ProviderDiff> m_pendingDiffs;
+
+    static const int BATCH_WINDOW = 200;     // 合并增量的时间窗口（毫秒）
+    static const int SHUTDOWN_TIMEOUT = 2000;
+};
+
+#endif // PROVIDERSCHEDULER_H
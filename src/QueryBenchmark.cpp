@@ -0,0 +1,211 @@
+#include "QueryBenchmark.h"
+#include "StatusQuery.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<qint64> g_allocations{0};
+
+    void countAllocation() {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const QStringList kIcons = {"📚", "💻", "☕", "🏃", "🍔", "😴", "📝", "⚡"};
+    const QStringList kWords = {"会议", "编码", "阅读", "午餐", "健身", "休息", "写作", "出差"};
+}
+
+// 替换全局分配函数以统计分配次数，开销只有一次原子加法
+void *operator new(std::size_t size) {
+    countAllocation();
+    if (void *pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#ifdef __GLIBC__
+// Qt 容器直接调用 malloc，glibc 下在可执行文件中覆盖 malloc 系列函数一并统计
+extern "C" {
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *pointer, size_t size);
+
+    void *malloc(size_t size) noexcept {
+        countAllocation();
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size) noexcept {
+        countAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *pointer, size_t size) noexcept {
+        countAllocation();
+        return __libc_realloc(pointer, size);
+    }
+}
+#endif
+
+QueryBenchmark::QueryBenchmark()
+    : m_statusCount(200000)
+      , m_queries(200)
+      , m_maxViewAllocs(0) {
+}
+
+qint64 QueryBenchmark::allocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+void QueryBenchmark::configure(const QStringList &arguments) {
+    for (const QString &argument : arguments) {
+        if (!argument.startsWith("--") || !argument.contains('=')) {
+            continue;
+        }
+        const QString key = argument.mid(2).section('=', 0, 0);
+        bool ok = false;
+        const qint64 value = argument.section('=', 1).toLongLong(&ok);
+        if (!ok) {
+            qWarning() << "无效的参数值:" << argument;
+        } else if (key == "statuses") {
+            m_statusCount = int(value);
+        } else if (key == "queries") {
+            m_queries = qMax(1, int(value));
+        } else if (key == "max-view-allocs") {
+            m_maxViewAllocs = value;
+        } else {
+            qWarning() << "未知参数:" << argument;
+        }
+    }
+}
+
+void QueryBenchmark::makeStatuses() {
+    QRandomGenerator random(20260211);
+    const QDateTime first = QDateTime::currentDateTime().addDays(-60);
+    const qint64 span = 67 * 86400;
+
+    m_statuses.clear();
+    m_statuses.reserve(m_statusCount);
+    for (int i = 0; i < m_statusCount; ++i) {
+        StatusData status;
+        status.icon = kIcons[random.bounded(kIcons.size())];
+        status.description = kWords[random.bounded(kWords.size())] + QString(" %1").arg(i);
+        status.startDateTime = first.addSecs(random.bounded(span));
+        status.durationHours = random.bounded(1, 9);
+        m_statuses.append(status);
+    }
+    std::sort(m_statuses.begin(), m_statuses.end(), [](const StatusData &a, const StatusData &b) {
+        return a.startDateTime < b.startDateTime;
+    });
+}
+
+void QueryBenchmark::measure(const QString &name, const std::function<qsizetype()> &view,
+                             const std::function<qsizetype()> &copy) {
+    qsizetype matches = 0;
+    QElapsedTimer timer;
+
+    qint64 allocations = allocationCount();
+    timer.start();
+    for (int i = 0; i < m_queries; ++i) {
+        matches = view();
+    }
+    const qint64 viewNs = timer.nsecsElapsed() / m_queries;
+    const qint64 viewAllocs = (allocationCount() - allocations) / m_queries;
+
+    allocations = allocationCount();
+    timer.restart();
+    for (int i = 0; i < m_queries; ++i) {
+        copy();
+    }
+    const qint64 copyNs = timer.nsecsElapsed() / m_queries;
+    const qint64 copyAllocs = (allocationCount() - allocations) / m_queries;
+
+    std::printf("query-bench scenario=%s matches=%lld view-allocs=%lld copy-allocs=%lld view-ns=%lld copy-ns=%lld\n",
+                qPrintable(name), static_cast<long long>(matches), static_cast<long long>(viewAllocs),
+                static_cast<long long>(copyAllocs), static_cast<long long>(viewNs),
+                static_cast<long long>(copyNs));
+    std::fflush(stdout);
+
+    if (viewAllocs > m_maxViewAllocs) {
+        m_violations << name;
+    }
+}
+
+int QueryBenchmark::run() {
+#ifdef __GLIBC__
+    std::printf("query-bench statuses=%d queries=%d counting=new+malloc\n", m_statusCount, m_queries);
+#else
+    std::printf("query-bench statuses=%d queries=%d counting=new\n", m_statusCount, m_queries);
+#endif
+    makeStatuses();
+
+    const QDateTime now = QDateTime::currentDateTime();
+    const QString icon = kIcons.first();
+    const QString text = kWords.first();
+
+    // 视图方式：遍历并计数；复制方式：与 getActiveStatuses() 等便捷函数相同，逐个复制到 QVector
+    auto variants = [this](const std::function<StatusQuery(StatusQuery)> &build) {
+        return std::pair<std::function<qsizetype()>, std::function<qsizetype()>>(
+            [this, build]() {
+                qsizetype count = 0;
+                for ([[maybe_unused]] const StatusData &status : build(StatusQuery(m_statuses)).view()) {
+                    ++count;
+                }
+                return count;
+            },
+            [this, build]() {
+                QVector<StatusData> result;
+                for (const StatusData &status : build(StatusQuery(m_statuses)).view()) {
+                    result.append(status);
+                }
+                return result.size();
+            });
+    };
+
+    const std::pair<QString, std::function<StatusQuery(StatusQuery)>> scenarios[] = {
+        {"active", [now](StatusQuery query) { return query.activeAt(now); }},
+        {"expired-page", [now](StatusQuery query) {
+            return query.expiredAt(now).order(Qt::DescendingOrder).limit(50);
+        }},
+        {"window", [now](StatusQuery query) { return query.overlapping(now.addDays(-1), now.addDays(1)); }},
+        {"icon", [now, icon](StatusQuery query) { return query.overlapping(now.addDays(-7), now).withIcon(icon); }},
+        {"text", [text](StatusQuery query) { return query.containing(text).limit(100); }},
+    };
+    for (const auto &[name, build] : scenarios) {
+        const auto [view, copy] = variants(build);
+        measure(name, view, copy);
+    }
+
+    for (const QString &violation : std::as_const(m_violations)) {
+        std::printf("query-bench over-budget %s view-allocs\n", qPrintable(violation));
+    }
+    std::printf("query-bench result=%s\n", m_violations.isEmpty() ? "pass" : "fail");
+    std::fflush(stdout);
+    return m_violations.isEmpty() ? 0 : 1;
+}
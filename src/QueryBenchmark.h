@@ -0,0 +1,58 @@
+#ifndef QUERYBENCHMARK_H
+#define QUERYBENCHMARK_H
+
+#include <QStringList>
+#include <QVector>
+#include <functional>
+#include "StatusData.h"
+
+/**
+ * @brief 状态查询的内存分配次数与耗时测量（--query-bench）
+ *
+ * 在生成的大量状态上，对每种查询分别测量惰性视图遍历与复制为 QVector 两种方式
+ * 每次查询的内存分配次数和耗时，每种查询输出一行：
+ *     query-bench scenario=active matches=.. view-allocs=0 copy-allocs=.. view-ns=.. copy-ns=..
+ * 视图遍历的分配次数超过 --max-view-allocs（默认0）时以1退出。
+ * 分配次数统计 operator new，glibc 下还统计 malloc 系列函数（Qt 容器直接使用 malloc），
+ * 第一行注明统计范围。参数 --statuses=N、--queries=N 可调整数据规模和重复次数。
+ */
+class QueryBenchmark {
+public:
+    QueryBenchmark();
+
+    /**
+     * @brief 读取 --名称=值 形式的参数
+     */
+    void configure(const QStringList &arguments);
+
+    /**
+     * @brief 运行全部场景
+     * @return 退出码，超出预算时为1
+     */
+    int run();
+
+    /**
+     * @brief 进程启动以来的内存分配次数
+     */
+    static qint64 allocationCount();
+
+private:
+    /**
+     * @brief 生成按起始时间排序的测试数据：过去60天到未来7天，时长1-8小时
+     */
+    void makeStatuses();
+
+    /**
+     * @brief 测量一种查询：view 遍历视图返回匹配数，copy 复制结果返回匹配数
+     */
+    void measure(const QString &name, const std::function<qsizetype()> &view,
+                 const std::function<qsizetype()> &copy);
+
+    QVector<StatusData> m_statuses;
+    int m_statusCount;
+    int m_queries;
+    qint64 m_maxViewAllocs;
+    QStringList m_violations;
+};
+
+#endif // QUERYBENCHMARK_H
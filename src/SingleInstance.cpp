@@ -0,0 +1,124 @@
+#include "SingleInstance.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QLocalSocket>
+#include <QThread>
+
+namespace {
+    const quint32 kForwardMagic = 0x53544649; // "STFI"
+    const char kForwardAck = 1;
+
+    /**
+     * @brief 套接字名称：每个用户、每个数据目录一个
+     */
+    QString serverNameFor(const QString &dataDir) {
+        QByteArray key = QDir(dataDir).absolutePath().toUtf8() + '\x1f' + qgetenv("USER") + qgetenv("USERNAME");
+        return "StatusDisplayApp-" + QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex().left(16);
+    }
+}
+
+SingleInstance::SingleInstance(const QString &dataDir, QObject *parent)
+    : QObject(parent)
+      , m_lock(QDir(dataDir).absoluteFilePath("status.lock"))
+      , m_serverName(serverNameFor(dataDir))
+      , m_server(nullptr) {
+    // 只按持有进程是否存在判断锁是否失效，长时间运行的实例的锁不会过期
+    m_lock.setStaleLockTime(0);
+}
+
+SingleInstance::~SingleInstance() {
+    if (m_server) {
+        m_server->close();
+    }
+    m_lock.unlock();
+}
+
+bool SingleInstance::tryLock() {
+    return m_lock.tryLock(0);
+}
+
+bool SingleInstance::listen() {
+    if (!m_lock.isLocked()) {
+        return false;
+    }
+    if (!m_server) {
+        m_server = new QLocalServer(this);
+        m_server->setSocketOptions(QLocalServer::UserAccessOption);
+        connect(m_server, &QLocalServer::newConnection, this, &SingleInstance::onNewConnection);
+    }
+
+    if (!m_server->listen(m_serverName)) {
+        // 已持有锁，同名套接字只可能是异常退出的实例遗留的
+        QLocalServer::removeServer(m_serverName);
+        if (!m_server->listen(m_serverName)) {
+            qWarning() << "无法监听本地套接字:" << m_server->errorString();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SingleInstance::forward(const QStringList &arguments, int timeoutMs) {
+    QDeadlineTimer deadline(timeoutMs);
+    QLocalSocket socket;
+
+    // 第一个实例刚取得锁时可能还没开始监听
+    for (;;) {
+        socket.connectToServer(m_serverName);
+        if (socket.waitForConnected(int(deadline.remainingTime()))) {
+            break;
+        }
+        if (deadline.hasExpired()) {
+            qWarning() << "无法连接到已运行的实例:" << socket.errorString();
+            return false;
+        }
+        QThread::msleep(CONNECT_RETRY_DELAY);
+    }
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kForwardMagic << arguments;
+    socket.write(payload);
+
+    // 等待确认，确保第一个实例已收到后再退出
+    while (socket.bytesAvailable() < 1) {
+        if (deadline.hasExpired() || !socket.waitForReadyRead(int(deadline.remainingTime()))) {
+            qWarning() << "已运行的实例没有响应";
+            return false;
+        }
+    }
+    char ack = 0;
+    socket.getChar(&ack);
+    socket.disconnectFromServer();
+    return ack == kForwardAck;
+}
+
+void SingleInstance::onNewConnection() {
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            QDataStream stream(socket);
+            stream.setVersion(QDataStream::Qt_6_0);
+            stream.startTransaction();
+            quint32 magic = 0;
+            QStringList arguments;
+            stream >> magic >> arguments;
+            if (!stream.commitTransaction()) {
+                return; // 数据未收全
+            }
+
+            if (magic != kForwardMagic) {
+                qWarning() << "忽略格式不符的转发请求";
+                socket->disconnectFromServer();
+                return;
+            }
+            socket->putChar(kForwardAck);
+            socket->flush();
+            emit argumentsReceived(arguments);
+        });
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef SINGLEINSTANCE_H
+#define SINGLEINSTANCE_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLockFile>
+#include <QStringList>
+
+/**
+ * @brief 单实例：同一数据目录只运行一个程序实例
+ *
+ * 第一个实例持有数据目录下的锁文件并监听本地套接字；之后启动的实例取锁失败，
+ * 把命令行参数转发给第一个实例后直接退出，不创建窗口也不加载数据。
+ * 锁文件在进程异常退出后自动失效，保证不会有两个进程同时写数据文件。
+ *
+ * 转发格式（QDataStream）：magic、参数列表；第一个实例收到后回复一个字节。
+ */
+class SingleInstance : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 可在 QApplication 创建之前构造
+     * @param dataDir 数据目录，锁文件和套接字名称由它确定
+     */
+    explicit SingleInstance(const QString &dataDir, QObject *parent = nullptr);
+
+    ~SingleInstance();
+
+    /**
+     * @brief 尝试成为第一个实例，不等待
+     */
+    bool tryLock();
+
+    /**
+     * @brief 开始接收其他实例转发的参数（需已获得锁且事件循环可用）
+     */
+    bool listen();
+
+    /**
+     * @brief 把参数转发给第一个实例（阻塞，最长 timeoutMs 毫秒）
+     * @return 第一个实例是否已收到
+     */
+    bool forward(const QStringList &arguments, int timeoutMs = FORWARD_TIMEOUT);
+
+    QString serverName() const { return m_serverName; }
+
+signals:
+    /**
+     * @brief 收到其他实例转发的参数（不含程序名）
+     */
+    void argumentsReceived(const QStringList &arguments);
+
+private slots:
+    void onNewConnection();
+
+private:
+    QLockFile m_lock;
+    QString m_serverName;
+    QLocalServer *m_server;
+
+    static const int FORWARD_TIMEOUT = 3000;   // 第一个实例可能仍在启动（毫秒）
+    static const int CONNECT_RETRY_DELAY = 20; // 连接失败后重试间隔（毫秒）
+};
+
+#endif // SINGLEINSTANCE_H
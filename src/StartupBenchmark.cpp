@@ -0,0 +1,47 @@
+#include "StartupBenchmark.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QTimer>
+#include <cstdio>
+
+StartupBenchmark::StartupBenchmark(StatusManager *manager, const QElapsedTimer &clock, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager)
+      , m_clock(clock)
+      , m_firstPaint(-1)
+      , m_loaded(-1) {
+    connect(m_statusManager, &StatusManager::loadFinished, this, &StartupBenchmark::onLoadFinished);
+}
+
+void StartupBenchmark::watch(QWidget *window) {
+    window->installEventFilter(this);
+}
+
+bool StartupBenchmark::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::Paint && m_firstPaint < 0) {
+        m_firstPaint = m_clock.elapsed();
+        watched->removeEventFilter(this);
+        // 绘制完成后再检查，避免在绘制过程中退出
+        QTimer::singleShot(0, this, &StartupBenchmark::reportIfDone);
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void StartupBenchmark::onLoadFinished() {
+    if (m_loaded < 0) {
+        m_loaded = m_clock.elapsed();
+        reportIfDone();
+    }
+}
+
+void StartupBenchmark::reportIfDone() {
+    if (m_firstPaint < 0 || m_loaded < 0) {
+        return;
+    }
+
+    std::printf("startup-bench first-paint-ms=%lld loaded-ms=%lld statuses=%lld\n",
+                static_cast<long long>(m_firstPaint), static_cast<long long>(m_loaded),
+                static_cast<long long>(m_statusManager->getAllStatuses().size()));
+    std::fflush(stdout);
+    QCoreApplication::quit();
+}
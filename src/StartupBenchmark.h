@@ -0,0 +1,45 @@
+#ifndef STARTUPBENCHMARK_H
+#define STARTUPBENCHMARK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QWidget>
+#include "StatusManager.h"
+
+/**
+ * @brief 启动耗时测量（--startup-bench）
+ *
+ * 分别记录从进程启动到主窗口首次绘制、到完整数据加载完成的时间，
+ * 两者都得到后输出一行结果并退出程序，便于脚本多次运行取统计值：
+ *     startup-bench first-paint-ms=12 loaded-ms=840 statuses=200000
+ */
+class StartupBenchmark : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @param clock 进程启动时开始计时的计时器
+     */
+    StartupBenchmark(StatusManager *manager, const QElapsedTimer &clock, QObject *parent = nullptr);
+
+    /**
+     * @brief 监视主窗口的首次绘制
+     */
+    void watch(QWidget *window);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void onLoadFinished();
+
+private:
+    void reportIfDone();
+
+    StatusManager *m_statusManager;
+    QElapsedTimer m_clock;
+    qint64 m_firstPaint;
+    qint64 m_loaded;
+};
+
+#endif // STARTUPBENCHMARK_H
@@ -0,0 +1,112 @@
+#include "StartupSnapshot.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+
+namespace {
+    const quint32 kSnapshotMagic = 0x5354534E; // "STSN"
+    const quint16 kSnapshotVersion = 2;
+}
+
+StartupSnapshot::StartupSnapshot(StatusManager *manager, const QString &filePath, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager)
+      , m_filePath(filePath)
+      , m_ready(false) {
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY);
+    connect(m_saveTimer, &QTimer::timeout, this, &StartupSnapshot::save);
+
+    connect(m_statusManager, &StatusManager::statusesChanged, this, &StartupSnapshot::scheduleSave);
+    connect(m_statusManager, &StatusManager::loadFinished, this, &StartupSnapshot::onLoadFinished);
+}
+
+StartupSnapshot::~StartupSnapshot() {
+    // 退出时保存，下次启动的快照尽量新
+    save();
+}
+
+QVector<StatusData> StartupSnapshot::load(const QString &filePath) {
+    QVector<StatusData> statuses;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return statuses;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint64 savedAt = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> savedAt >> count;
+    if (magic != kSnapshotMagic || version != kSnapshotVersion || count > MAX_ENTRIES) {
+        return statuses;
+    }
+
+    statuses.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        StatusData status;
+        qint64 startSecs = 0;
+        qint32 duration = 0;
+        qint32 priority = 0;
+        stream >> status.uid >> status.icon >> status.description >> startSecs >> duration >> priority
+                >> status.modifiedAt;
+        status.startDateTime = QDateTime::fromSecsSinceEpoch(startSecs);
+        status.durationHours = duration;
+        status.priority = priority;
+        statuses.append(status);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "启动快照损坏:" << filePath;
+        statuses.clear();
+    }
+    return statuses;
+}
+
+void StartupSnapshot::scheduleSave() {
+    if (m_ready) {
+        m_saveTimer->start();
+    }
+}
+
+void StartupSnapshot::onLoadFinished(bool ok) {
+    // --reload 失败时保留原有数据，之前已完整加载过就继续保存
+    m_ready = m_ready || ok;
+    scheduleSave();
+}
+
+void StartupSnapshot::save() {
+    // 加载完成前只有临时视图，加载失败时数据不完整，都不保存
+    if (!m_ready || m_statusManager->isLoading()) {
+        return;
+    }
+    m_saveTimer->stop();
+
+    const QDateTime now = QDateTime::currentDateTime();
+    QVector<StatusData> statuses;
+    for (const StatusData &status : m_statusManager->query().overlapping(now, now.addSecs(HORIZON))
+                                                            .limit(MAX_ENTRIES).view()) {
+        statuses.append(status);
+    }
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "无法写入启动快照:" << m_filePath;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kSnapshotMagic << kSnapshotVersion << now.toSecsSinceEpoch() << quint32(statuses.size());
+    for (const StatusData &status : std::as_const(statuses)) {
+        stream << status.uid << status.icon << status.description
+                << status.startDateTime.toSecsSinceEpoch() << qint32(status.durationHours)
+                << qint32(status.priority) << status.modifiedAt;
+    }
+    file.commit();
+}
@@ -0,0 +1,50 @@
+#ifndef STARTUPSNAPSHOT_H
+#define STARTUPSNAPSHOT_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include "StatusManager.h"
+
+/**
+ * @brief 启动快照：保存当前及接下来一段时间内有效的状态
+ *
+ * 启动时先用快照显示，完整数据在后台加载，加载完成后再以真实数据为准。
+ * 快照只包含与 [保存时间, 保存时间 + HORIZON] 相交的状态（最多 MAX_ENTRIES 个），
+ * 因此在此期间内启动，按快照计算的有效状态与完整数据一致（除非数据文件在程序外被修改）。
+ */
+class StartupSnapshot : public QObject {
+    Q_OBJECT
+
+public:
+    StartupSnapshot(StatusManager *manager, const QString &filePath, QObject *parent = nullptr);
+
+    ~StartupSnapshot();
+
+    /**
+     * @brief 读取快照，文件不存在或格式不符时返回空
+     */
+    static QVector<StatusData> load(const QString &filePath);
+
+    /**
+     * @brief 立即保存快照（完整数据成功加载前不保存）
+     */
+    void save();
+
+private slots:
+    void scheduleSave();
+
+    void onLoadFinished(bool ok);
+
+private:
+    StatusManager *m_statusManager;
+    QString m_filePath;
+    QTimer *m_saveTimer;
+    bool m_ready; // 完整数据已成功加载
+
+    static const int SAVE_DELAY = 1000;            // 合并连续修改（毫秒）
+    static const int HORIZON = 7 * 24 * 3600;      // 快照覆盖的时间范围（秒）
+    static const int MAX_ENTRIES = 256;
+};
+
+#endif // STARTUPSNAPSHOT_H
@@ -3,6 +3,9 @@
 
 #include <QString>
 #include <QDateTime>
+#include <QHashFunctions>
+#include <QUuid>
+#include "IsoTimestamp.h"
 
 /**
  * @brief 状态数据结构
@@ -12,9 +15,12 @@ struct StatusData {
     QString description; // 状态描述
     QDateTime startDateTime; // 起始时间（年月日时分）
     int durationHours; // 持续时长（小时）
+    int priority; // 优先级，越大越重要，默认0
+    QUuid uid; // 唯一标识（同步用，不参与相等比较）
+    qint64 modifiedAt; // 最后修改时间（UTC毫秒，同步冲突时后写入者优先）
 
     // 兼容旧格式的构造函数
-    StatusData() : durationHours(1) {
+    StatusData() : durationHours(1), priority(0), modifiedAt(0) {
         startDateTime = QDateTime::currentDateTime();
     }
 
@@ -25,54 +31,84 @@ struct StatusData {
                durationHours == other.durationHours;
     }
 
+    /**
+     * @brief 获取结束时间
+     */
+    QDateTime endDateTime() const {
+        return startDateTime.addSecs(durationHours * 3600);
+    }
+
+    /**
+     * @brief 检查状态在指定时刻是否有效
+     */
+    bool isActiveAt(const QDateTime &time) const {
+        return time >= startDateTime && time < endDateTime();
+    }
+
+    /**
+     * @brief 检查状态在指定时刻是否已过期
+     */
+    bool isExpiredAt(const QDateTime &time) const {
+        return time >= endDateTime();
+    }
+
     /**
      * @brief 检查状态是否在当前时间有效
      */
     bool isActive() const {
-        QDateTime now = QDateTime::currentDateTime();
-        QDateTime endDateTime = startDateTime.addSecs(durationHours * 3600);
-
-        return now >= startDateTime && now < endDateTime;
+        return isActiveAt(QDateTime::currentDateTime());
     }
 
     /**
      * @brief 检查状态是否已过期
      */
     bool isExpired() const {
-        QDateTime now = QDateTime::currentDateTime();
-        QDateTime endDateTime = startDateTime.addSecs(durationHours * 3600);
-
-        return now >= endDateTime;
+        return isExpiredAt(QDateTime::currentDateTime());
     }
 
     /**
      * @brief 获取时间范围字符串
      */
     QString getTimeRange() const {
-        QDateTime endDateTime = startDateTime.addSecs(durationHours * 3600);
-        return QString("%1 - %2")
-                .arg(startDateTime.toString("yyyy-MM-dd hh:mm"))
-                .arg(endDateTime.toString("yyyy-MM-dd hh:mm"));
+        return IsoTimestamp::formatRange(startDateTime, endDateTime(), IsoTimestamp::DateTimeMinutes);
     }
 
     /**
      * @brief 获取简短的时间范围（仅时间）
      */
     QString getShortTimeRange() const {
-        QDateTime endDateTime = startDateTime.addSecs(durationHours * 3600);
+        QDateTime end = endDateTime();
 
         // 如果是同一天，只显示时间
-        if (startDateTime.date() == endDateTime.date()) {
-            return QString("%1 - %2")
-                    .arg(startDateTime.toString("hh:mm"))
-                    .arg(endDateTime.toString("hh:mm"));
+        if (startDateTime.date() == end.date()) {
+            return IsoTimestamp::formatRange(startDateTime, end, IsoTimestamp::Minutes);
         } else {
             // 跨天显示日期
-            return QString("%1 - %2")
-                    .arg(startDateTime.toString("MM-dd hh:mm"))
-                    .arg(endDateTime.toString("MM-dd hh:mm"));
+            return IsoTimestamp::formatRange(startDateTime, end, IsoTimestamp::MonthDayMinutes);
         }
     }
 };
 
+/**
+ * @brief 状态哈希，与 operator== 使用相同的字段（图标、描述、起始时间、持续时长）
+ */
+inline size_t qHash(const StatusData &status, size_t seed = 0) {
+    return qHashMulti(seed, status.icon, status.description, status.startDateTime, status.durationHours);
+}
+
+/**
+ * @brief 连同优先级一起比较的状态，用于只有优先级变化也需要识别的场合（后台提供者的结果比较）
+ */
+struct PrioritizedStatus {
+    StatusData status;
+
+    bool operator==(const PrioritizedStatus &other) const {
+        return status == other.status && status.priority == other.status.priority;
+    }
+};
+
+inline size_t qHash(const PrioritizedStatus &entry, size_t seed = 0) {
+    return qHashMulti(seed, entry.status, entry.status.priority);
+}
+
 #endif // STATUSDATA_H
@@ -0,0 +1,67 @@
+#include "StatusEventHooks.h"
+#include "IsoTimestamp.h"
+#include <QDebug>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QSettings>
+
+StatusEventHooks::StatusEventHooks(StatusManager *manager, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager) {
+    connect(m_statusManager, &StatusManager::statusReminder, this, [this](const StatusData &status) {
+        run(m_reminderCommand, "reminder", status);
+    });
+    connect(m_statusManager, &StatusManager::statusStarted, this, [this](const StatusData &status) {
+        run(m_startCommand, "start", status);
+    });
+    connect(m_statusManager, &StatusManager::statusEnded, this, [this](const StatusData &status) {
+        run(m_endCommand, "end", status);
+    });
+}
+
+void StatusEventHooks::loadFromSettings() {
+    QSettings settings("StatusApp", "StatusDisplayApp");
+    m_statusManager->setReminderMinutes(settings.value("events/reminderMinutes", 5).toInt());
+
+    setReminderCommand(settings.value("events/reminderProgram").toString(),
+                       settings.value("events/reminderArguments").toStringList());
+    setStartCommand(settings.value("events/startProgram").toString(),
+                    settings.value("events/startArguments").toStringList());
+    setEndCommand(settings.value("events/endProgram").toString(),
+                  settings.value("events/endArguments").toStringList());
+}
+
+void StatusEventHooks::setReminderCommand(const QString &program, const QStringList &arguments) {
+    m_reminderCommand = {program, arguments};
+}
+
+void StatusEventHooks::setStartCommand(const QString &program, const QStringList &arguments) {
+    m_startCommand = {program, arguments};
+}
+
+void StatusEventHooks::setEndCommand(const QString &program, const QStringList &arguments) {
+    m_endCommand = {program, arguments};
+}
+
+void StatusEventHooks::run(const Command &command, const QString &event, const StatusData &status) const {
+    if (command.program.isEmpty()) {
+        return;
+    }
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("STATUS_EVENT", event);
+    environment.insert("STATUS_ICON", status.icon);
+    environment.insert("STATUS_DESCRIPTION", status.description);
+    environment.insert("STATUS_START", IsoTimestamp::format(status.startDateTime));
+    environment.insert("STATUS_END", IsoTimestamp::format(status.endDateTime()));
+    environment.insert("STATUS_PRIORITY", QString::number(status.priority));
+    environment.insert("STATUS_UID", status.uid.toString(QUuid::WithoutBraces));
+
+    QProcess process;
+    process.setProgram(command.program);
+    process.setArguments(command.arguments);
+    process.setProcessEnvironment(environment);
+    if (!process.startDetached()) {
+        qWarning() << "无法运行事件命令:" << command.program;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef STATUSEVENTHOOKS_H
+#define STATUSEVENTHOOKS_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include "StatusManager.h"
+
+/**
+ * @brief 状态事件的本地命令钩子
+ *
+ * 状态开始前提醒、开始、结束时分别运行配置的命令（独立进程，不等待结束），
+ * 状态信息通过环境变量传入：STATUS_EVENT（reminder/start/end）、STATUS_ICON、
+ * STATUS_DESCRIPTION、STATUS_START、STATUS_END、STATUS_PRIORITY、STATUS_UID。
+ */
+class StatusEventHooks : public QObject {
+    Q_OBJECT
+
+public:
+    explicit StatusEventHooks(StatusManager *manager, QObject *parent = nullptr);
+
+    /**
+     * @brief 从设置读取提醒提前时间和各事件的命令
+     */
+    void loadFromSettings();
+
+    /**
+     * @brief 设置事件的命令，program 为空表示不运行
+     */
+    void setReminderCommand(const QString &program, const QStringList &arguments);
+
+    void setStartCommand(const QString &program, const QStringList &arguments);
+
+    void setEndCommand(const QString &program, const QStringList &arguments);
+
+private:
+    struct Command {
+        QString program;
+        QStringList arguments;
+    };
+
+    void run(const Command &command, const QString &event, const StatusData &status) const;
+
+    StatusManager *m_statusManager;
+    Command m_reminderCommand;
+    Command m_startCommand;
+    Command m_endCommand;
+};
+
+#endif // STATUSEVENTHOOKS_H
@@ -0,0 +1,111 @@
+#include "StatusEventSchedule.h"
+#include <QDateTime>
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief 时间轮中的附加数据：记录序号和事件类型
+     */
+    quint64 makePayload(qint32 record, StatusEvent::Type type) {
+        return (quint64(record) << 2) | quint64(type);
+    }
+}
+
+StatusEventSchedule::StatusEventSchedule()
+    : m_wheel(QDateTime::currentSecsSinceEpoch() + 1)
+      , m_reminderLead(0) {
+}
+
+void StatusEventSchedule::reset(const QVector<StatusData> &statuses, qint64 now) {
+    m_wheel.reset(now + 1);
+    m_records.clear();
+    m_freeRecords.clear();
+    m_recordsByUid.clear();
+    for (const StatusData &status : statuses) {
+        insert(status);
+    }
+}
+
+void StatusEventSchedule::insert(const StatusData &status) {
+    if (!status.startDateTime.isValid()) {
+        return;
+    }
+    const qint64 start = status.startDateTime.toSecsSinceEpoch();
+    const qint64 end = start + status.durationHours * qint64(3600);
+    const qint64 times[3] = {m_reminderLead > 0 ? start - m_reminderLead : -1, start, end};
+
+    // 已发生的事件不再安排，全部已发生的状态不占用记录
+    const qint64 first = m_wheel.currentTime();
+    if (end < first) {
+        return;
+    }
+
+    qint32 index;
+    if (!m_freeRecords.empty()) {
+        index = m_freeRecords.back();
+        m_freeRecords.pop_back();
+    } else {
+        index = qint32(m_records.size());
+        m_records.emplace_back();
+    }
+
+    Record &record = m_records[index];
+    record.status = status;
+    record.start = start;
+    record.pending = 0;
+    for (int type = StatusEvent::Reminder; type <= StatusEvent::End; ++type) {
+        record.handles[type] = TimingWheel::InvalidHandle;
+        if (times[type] >= first) {
+            record.handles[type] = m_wheel.schedule(times[type], makePayload(index, StatusEvent::Type(type)));
+            ++record.pending;
+        }
+    }
+    m_recordsByUid.insert(status.uid, index);
+}
+
+void StatusEventSchedule::remove(const StatusData &status) {
+    for (auto it = m_recordsByUid.find(status.uid); it != m_recordsByUid.end() && it.key() == status.uid; ++it) {
+        Record &record = m_records[*it];
+        if (record.status == status) {
+            for (TimingWheel::Handle handle : record.handles) {
+                m_wheel.cancel(handle);
+            }
+            releaseRecord(*it);
+            return;
+        }
+    }
+}
+
+void StatusEventSchedule::releaseRecord(qint32 index) {
+    Record &record = m_records[index];
+    m_recordsByUid.remove(record.status.uid, index);
+    record.status = StatusData();
+    m_freeRecords.push_back(index);
+}
+
+void StatusEventSchedule::advance(qint64 now, QVector<StatusEvent> &fired) {
+    m_expired.clear();
+    m_wheel.advance(now, m_expired);
+
+    // 时间轮不保证同一秒内的顺序，时长为0的状态也要先开始后结束
+    std::stable_sort(m_expired.begin(), m_expired.end(),
+                     [](const TimingWheel::Expired &lhs, const TimingWheel::Expired &rhs) {
+                         if (lhs.expires != rhs.expires) return lhs.expires < rhs.expires;
+                         return (lhs.payload & 3) < (rhs.payload & 3);
+                     });
+
+    for (const TimingWheel::Expired &expired : m_expired) {
+        const qint32 index = qint32(expired.payload >> 2);
+        const StatusEvent::Type type = StatusEvent::Type(expired.payload & 3);
+        Record &record = m_records[index];
+        record.handles[type] = TimingWheel::InvalidHandle;
+
+        // 休眠期间错过的提醒，状态已经开始时不再提示
+        if (type != StatusEvent::Reminder || record.start > now) {
+            fired.append({type, expired.expires, record.status});
+        }
+        if (--record.pending == 0) {
+            releaseRecord(index);
+        }
+    }
+}
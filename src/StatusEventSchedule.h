@@ -0,0 +1,97 @@
+#ifndef STATUSEVENTSCHEDULE_H
+#define STATUSEVENTSCHEDULE_H
+
+#include <QMultiHash>
+#include <QVector>
+#include <vector>
+#include "StatusData.h"
+#include "TimingWheel.h"
+
+/**
+ * @brief 状态的一个时间点事件
+ */
+struct StatusEvent {
+    enum Type {
+        Reminder, // 开始前提醒
+        Start,
+        End
+    };
+
+    Type type;
+    qint64 time; // 事件时间（UTC秒）
+    StatusData status;
+};
+
+/**
+ * @brief 所有状态的提醒、开始、结束事件，基于分层时间轮
+ *
+ * 每个状态在时间轮中最多有三个事件，只安排尚未发生的事件。
+ * 添加、删除一个状态为 O(1)，推进时只处理到期的事件。
+ */
+class StatusEventSchedule {
+public:
+    StatusEventSchedule();
+
+    /**
+     * @brief 提醒提前的秒数，0表示不提醒；下一次 reset() 起生效
+     */
+    void setReminderLead(qint64 secs) { m_reminderLead = secs; }
+
+    qint64 reminderLead() const { return m_reminderLead; }
+
+    /**
+     * @brief 清空后按给定时刻重新安排，now 及之前的事件视为已发生
+     */
+    void reset(const QVector<StatusData> &statuses, qint64 now);
+
+    void insert(const StatusData &status);
+
+    /**
+     * @brief 取消一个内容、标识相同的状态的全部事件
+     */
+    void remove(const StatusData &status);
+
+    /**
+     * @brief 推进到 now，按时间顺序输出到期的事件
+     *
+     * 休眠后追赶时，开始和结束照常输出；状态已经开始的提醒不再输出。
+     */
+    void advance(qint64 now, QVector<StatusEvent> &fired);
+
+    /**
+     * @brief 下一次需要推进的时间（UTC秒），没有事件时返回-1
+     */
+    qint64 nextWakeup() const { return m_wheel.nextWakeup(); }
+
+    /**
+     * @brief 已处理到的时刻（UTC秒）
+     */
+    qint64 currentSecs() const { return m_wheel.currentTime() - 1; }
+
+    /**
+     * @brief 尚未发生的事件数
+     */
+    qsizetype pendingCount() const { return m_wheel.size(); }
+
+private:
+    /**
+     * @brief 一个状态尚未发生的事件
+     */
+    struct Record {
+        StatusData status;
+        qint64 start;
+        TimingWheel::Handle handles[3]; // 按 StatusEvent::Type 索引
+        int pending;
+    };
+
+    void releaseRecord(qint32 index);
+
+    TimingWheel m_wheel;
+    std::vector<Record> m_records;
+    std::vector<qint32> m_freeRecords;
+    QMultiHash<QUuid, qint32> m_recordsByUid;
+    std::vector<TimingWheel::Expired> m_expired;
+    qint64 m_reminderLead;
+};
+
+#endif // STATUSEVENTSCHEDULE_H
@@ -0,0 +1,510 @@
+#include "StatusImporter.h"
+#include "IsoTimestamp.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QTimeZone>
+#include <QtConcurrent>
+#include <QDebug>
+
+namespace {
+    constexpr int kProgressInterval = 4096; // 每解析多少行更新一次进度
+    const QString kDefaultCalendarIcon = QStringLiteral("📅");
+
+    /**
+     * @brief 按RFC 4180拆分一条CSV记录，引号未闭合时返回false
+     */
+    bool splitCsvRecord(QStringView record, QStringList &fields) {
+        fields.clear();
+        QString field;
+        bool quoted = false;
+
+        for (qsizetype i = 0; i < record.size(); ++i) {
+            QChar c = record[i];
+            if (quoted) {
+                if (c == u'"') {
+                    if (i + 1 < record.size() && record[i + 1] == u'"') {
+                        field.append(u'"');
+                        ++i;
+                    } else {
+                        quoted = false;
+                    }
+                } else {
+                    field.append(c);
+                }
+            } else if (c == u'"') {
+                quoted = true;
+            } else if (c == u',') {
+                fields.append(field);
+                field.clear();
+            } else {
+                field.append(c);
+            }
+        }
+
+        fields.append(field);
+        return !quoted;
+    }
+
+    QDateTime parseCsvDateTime(const QString &text) {
+        QDateTime dateTime = IsoTimestamp::parse(text);
+        if (!dateTime.isValid()) {
+            dateTime = QDateTime::fromString(text, "yyyy-MM-dd HH:mm");
+        }
+        return dateTime;
+    }
+
+    bool csvRecordToStatus(const QStringList &fields, StatusData &status) {
+        if (fields.size() < 4) {
+            return false;
+        }
+
+        bool ok = false;
+        status.icon = fields[0].trimmed();
+        status.description = fields[1].trimmed();
+        status.startDateTime = parseCsvDateTime(fields[2].trimmed());
+        status.durationHours = fields[3].trimmed().toInt(&ok);
+
+        // 第5列（优先级）可选
+        if (ok && fields.size() > 4 && !fields[4].trimmed().isEmpty()) {
+            status.priority = fields[4].trimmed().toInt(&ok);
+        }
+
+        return ok && status.durationHours > 0 && status.startDateTime.isValid()
+               && !status.icon.isEmpty();
+    }
+
+    /**
+     * @brief 取属性参数的值，如 DTSTART;TZID=Asia/Shanghai 中的 TZID，不存在时返回空
+     */
+    QString icsParameter(QStringView nameAndParams, QStringView key) {
+        for (QStringView param : nameAndParams.split(u';').mid(1)) {
+            qsizetype equals = param.indexOf(u'=');
+            if (equals > 0 && param.left(equals).compare(key, Qt::CaseInsensitive) == 0) {
+                QStringView value = param.mid(equals + 1);
+                if (value.size() >= 2 && value.startsWith(u'"') && value.endsWith(u'"')) {
+                    value = value.sliced(1, value.size() - 2);
+                }
+                return value.toString();
+            }
+        }
+        return QString();
+    }
+
+    /**
+     * @brief 按TZID查找时区，支持IANA名称和Windows时区名称
+     */
+    QTimeZone icsTimeZone(const QString &tzid) {
+        QTimeZone zone(tzid.toUtf8());
+        if (!zone.isValid()) {
+            zone = QTimeZone(QTimeZone::windowsIdToDefaultIanaId(tzid.toUtf8()));
+        }
+        return zone;
+    }
+
+    /**
+     * @brief 解析iCalendar日期时间：20260211T151307Z、20260211T151307 或 20260211
+     *
+     * 带TZID时按该时区解释后换算为本地时间；TZID无法识别（例如只在文件内VTIMEZONE中定义的自定义名称）
+     * 时按本地时间解释。全天日期总是按本地时间的0点。
+     */
+    QDateTime parseIcsDateTime(QStringView value, const QString &tzid = QString()) {
+        if (value.size() == 8) {
+            QDate date = QDate::fromString(value.toString(), "yyyyMMdd");
+            return QDateTime(date, QTime(0, 0));
+        }
+
+        bool utc = value.endsWith(u'Z');
+        QStringView local = utc ? value.chopped(1) : value;
+        QDateTime dateTime = QDateTime::fromString(local.toString(), "yyyyMMdd'T'HHmmss");
+        if (!dateTime.isValid()) {
+            return dateTime;
+        }
+        if (utc) {
+            return QDateTime(dateTime.date(), dateTime.time(), QTimeZone::UTC).toLocalTime();
+        }
+        if (!tzid.isEmpty()) {
+            QTimeZone zone = icsTimeZone(tzid);
+            if (zone.isValid()) {
+                return QDateTime(dateTime.date(), dateTime.time(), zone).toLocalTime();
+            }
+            qWarning() << "无法识别的时区，按本地时间处理:" << tzid;
+        }
+        return dateTime;
+    }
+
+    /**
+     * @brief 解析iCalendar时长（如 PT1H30M、P1D、P1W），返回秒数，失败返回-1
+     */
+    qint64 parseIcsDuration(QStringView value) {
+        if (value.startsWith(u'+')) {
+            value = value.mid(1);
+        }
+        if (!value.startsWith(u'P')) {
+            return -1;
+        }
+
+        qint64 total = 0;
+        qint64 number = 0;
+        bool hasNumber = false;
+        for (QChar c : value.mid(1)) {
+            if (c.isDigit()) {
+                number = number * 10 + c.digitValue();
+                hasNumber = true;
+                continue;
+            }
+            if (c == u'T') {
+                continue;
+            }
+            if (!hasNumber) {
+                return -1;
+            }
+            switch (c.unicode()) {
+                case u'W': total += number * 7 * 86400; break;
+                case u'D': total += number * 86400; break;
+                case u'H': total += number * 3600; break;
+                case u'M': total += number * 60; break;
+                case u'S': total += number; break;
+                default: return -1;
+            }
+            number = 0;
+            hasNumber = false;
+        }
+        return total;
+    }
+
+    QString unescapeIcsText(QStringView value) {
+        QString text;
+        text.reserve(value.size());
+        for (qsizetype i = 0; i < value.size(); ++i) {
+            QChar c = value[i];
+            if (c == u'\\' && i + 1 < value.size()) {
+                QChar next = value[++i];
+                text.append((next == u'n' || next == u'N') ? QChar(u'\n') : next);
+            } else {
+                text.append(c);
+            }
+        }
+        return text;
+    }
+
+    /**
+     * @brief 从日程标题中拆出开头的emoji作为图标
+     */
+    void splitSummary(const QString &summary, StatusData &status) {
+        qsizetype iconLength = 0;
+        if (!summary.isEmpty() && summary[0].isHighSurrogate() && summary.size() > 1) {
+            iconLength = 2;
+        } else if (!summary.isEmpty() && summary[0].category() == QChar::Symbol_Other) {
+            iconLength = 1;
+        }
+        // 包含变体选择符
+        if (iconLength > 0 && iconLength < summary.size() && summary[iconLength] == QChar(0xFE0F)) {
+            ++iconLength;
+        }
+
+        if (iconLength > 0) {
+            status.icon = summary.left(iconLength);
+            status.description = summary.mid(iconLength).trimmed();
+        } else {
+            status.icon = kDefaultCalendarIcon;
+            status.description = summary.trimmed();
+        }
+    }
+
+    /**
+     * @brief 逐个VEVENT收集属性
+     */
+    struct IcsEvent {
+        bool inEvent = false;
+        int nestedDepth = 0; // VEVENT内嵌套组件（VALARM等）的层数，其中的属性不属于日程本身
+        QString summary;
+        QDateTime start;
+        QDateTime end;
+        qint64 durationSecs = -1;
+        int priority = 0;
+
+        void reset() {
+            nestedDepth = 0;
+            priority = 0;
+            summary.clear();
+            start = QDateTime();
+            end = QDateTime();
+            durationSecs = -1;
+        }
+
+        bool toStatus(StatusData &status) const {
+            if (!start.isValid()) {
+                return false;
+            }
+            qint64 secs = durationSecs;
+            if (secs < 0 && end.isValid()) {
+                secs = start.secsTo(end);
+            }
+            if (secs < 0) {
+                secs = 3600;
+            }
+
+            splitSummary(summary, status);
+            status.startDateTime = start;
+            status.priority = priority;
+            status.durationHours = static_cast<int>(qMax<qint64>(1, (secs + 3599) / 3600));
+            return true;
+        }
+    };
+
+    /**
+     * @brief 处理一行已展开（unfold）的iCalendar内容
+     * @return 是否完成了一个VEVENT（结果写入status，ok表示是否有效）
+     */
+    bool handleIcsLine(QStringView line, IcsEvent &event, StatusData &status, bool &ok) {
+        if (line == u"BEGIN:VEVENT") {
+            event.inEvent = true;
+            event.reset();
+            return false;
+        }
+        if (!event.inEvent) {
+            return false;
+        }
+        if (line.startsWith(u"BEGIN:", Qt::CaseInsensitive)) {
+            ++event.nestedDepth;
+            return false;
+        }
+        if (event.nestedDepth > 0) {
+            if (line.startsWith(u"END:", Qt::CaseInsensitive)) {
+                --event.nestedDepth;
+            }
+            return false;
+        }
+        if (line == u"END:VEVENT") {
+            event.inEvent = false;
+            ok = event.toStatus(status);
+            return true;
+        }
+
+        qsizetype colon = line.indexOf(u':');
+        if (colon < 0) {
+            return false;
+        }
+        QStringView nameAndParams = line.left(colon);
+        QStringView value = line.mid(colon + 1);
+        qsizetype semicolon = nameAndParams.indexOf(u';');
+        QStringView name = semicolon < 0 ? nameAndParams : nameAndParams.left(semicolon);
+
+        if (name.compare(u"SUMMARY", Qt::CaseInsensitive) == 0) {
+            event.summary = unescapeIcsText(value);
+        } else if (name.compare(u"DTSTART", Qt::CaseInsensitive) == 0) {
+            event.start = parseIcsDateTime(value, icsParameter(nameAndParams, u"TZID"));
+        } else if (name.compare(u"DTEND", Qt::CaseInsensitive) == 0) {
+            event.end = parseIcsDateTime(value, icsParameter(nameAndParams, u"TZID"));
+        } else if (name.compare(u"DURATION", Qt::CaseInsensitive) == 0) {
+            event.durationSecs = parseIcsDuration(value);
+        } else if (name.compare(u"PRIORITY", Qt::CaseInsensitive) == 0) {
+            // iCalendar优先级1最高、9最低、0未定义，换算为越大越重要
+            int level = value.toInt();
+            event.priority = (level >= 1 && level <= 9) ? 10 - level : 0;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 逐行解析CSV或iCalendar内容
+     * @param accept 每条记录调用一次 accept(status, ok)
+     * @param checkpoint 每隔一批行调用一次，返回false时中止
+     * @return 是否解析到末尾
+     */
+    template <typename Accept, typename Checkpoint>
+    bool parseStream(QTextStream &stream, StatusImporter::Format format, Accept &&accept, Checkpoint &&checkpoint) {
+        QString line;
+        qint64 lineCount = 0;
+
+        // CSV：引号内的换行需要拼接多行；iCalendar：以空白开头的行是上一行的续行
+        QString pending;
+        QStringList fields;
+        IcsEvent event;
+        bool firstRecord = true;
+
+        auto handleCsv = [&](const QString &record) {
+            if (record.trimmed().isEmpty()) {
+                return;
+            }
+            if (!splitCsvRecord(record, fields)) {
+                accept(StatusData(), false);
+                return;
+            }
+            // 跳过表头
+            if (firstRecord) {
+                firstRecord = false;
+                if (fields.first().trimmed().compare("icon", Qt::CaseInsensitive) == 0) {
+                    return;
+                }
+            }
+            StatusData status;
+            bool ok = csvRecordToStatus(fields, status);
+            accept(status, ok);
+        };
+
+        auto handleIcs = [&](const QString &unfolded) {
+            StatusData status;
+            bool ok = false;
+            if (handleIcsLine(unfolded, event, status, ok)) {
+                accept(status, ok);
+            }
+        };
+
+        while (stream.readLineInto(&line)) {
+            if (format == StatusImporter::Csv) {
+                if (!pending.isEmpty()) {
+                    pending.append(u'\n');
+                    pending.append(line);
+                } else {
+                    pending = line;
+                }
+                if (pending.count(u'"') % 2 == 0) {
+                    handleCsv(pending);
+                    pending.clear();
+                }
+            } else {
+                if (!line.isEmpty() && (line[0] == u' ' || line[0] == u'\t')) {
+                    pending.append(QStringView(line).mid(1));
+                } else {
+                    if (!pending.isEmpty()) {
+                        handleIcs(pending);
+                    }
+                    pending = line;
+                }
+            }
+
+            if (++lineCount % kProgressInterval == 0 && !checkpoint()) {
+                return false;
+            }
+        }
+
+        if (!pending.isEmpty()) {
+            if (format == StatusImporter::Csv) {
+                accept(StatusData(), false); // 引号未闭合
+            } else {
+                handleIcs(pending);
+            }
+        }
+        return true;
+    }
+}
+
+StatusImporter::StatusImporter(StatusManager *manager, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager) {
+    connect(&m_watcher, &QFutureWatcher<ImportResult>::progressValueChanged,
+            this, &StatusImporter::progressChanged);
+    connect(&m_watcher, &QFutureWatcher<ImportResult>::finished,
+            this, &StatusImporter::onFinished);
+}
+
+StatusImporter::~StatusImporter() {
+    cancel();
+    m_watcher.waitForFinished();
+}
+
+StatusImporter::Format StatusImporter::formatForFile(const QString &filePath) {
+    QString suffix = QFileInfo(filePath).suffix().toLower();
+    return (suffix == "ics" || suffix == "ical") ? ICalendar : Csv;
+}
+
+QVector<StatusData> StatusImporter::parse(QIODevice *device, Format format, int *invalid) {
+    QVector<StatusData> statuses;
+    int invalidCount = 0;
+    QTextStream stream(device);
+    parseStream(stream, format, [&](const StatusData &status, bool ok) {
+        if (ok) {
+            statuses.append(status);
+        } else {
+            ++invalidCount;
+        }
+    }, []() { return true; });
+
+    if (invalid) {
+        *invalid = invalidCount;
+    }
+    return statuses;
+}
+
+void StatusImporter::start(const QString &filePath) {
+    if (isRunning()) {
+        return;
+    }
+
+    // 已有状态的快照（隐式共享，不复制数据），去重集合在工作线程中建立
+    m_watcher.setFuture(QtConcurrent::run(&StatusImporter::run, filePath,
+                                          m_statusManager->getAllStatuses()));
+}
+
+void StatusImporter::cancel() {
+    m_watcher.cancel();
+}
+
+bool StatusImporter::isRunning() const {
+    return m_watcher.isRunning();
+}
+
+void StatusImporter::run(QPromise<ImportResult> &promise, const QString &filePath,
+                         const QVector<StatusData> &existing) {
+    ImportResult result;
+    promise.setProgressRange(0, PROGRESS_RANGE);
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        result.error = "无法打开文件：" + filePath;
+        promise.addResult(result);
+        return;
+    }
+
+    QSet<StatusData> known;
+    known.reserve(existing.size());
+    for (const StatusData &status : existing) {
+        known.insert(status);
+    }
+
+    auto accept = [&](const StatusData &status, bool ok) {
+        if (!ok) {
+            ++result.invalid;
+        } else if (known.contains(status)) {
+            ++result.duplicates;
+        } else {
+            known.insert(status);
+            result.statuses.append(status);
+        }
+    };
+
+    const qint64 totalBytes = qMax<qint64>(file.size(), 1);
+    QTextStream stream(&file);
+    bool completed = parseStream(stream, formatForFile(filePath), accept, [&]() {
+        if (promise.isCanceled()) {
+            return false;
+        }
+        promise.setProgressValue(static_cast<int>(file.pos() * PROGRESS_RANGE / totalBytes));
+        return true;
+    });
+    if (!completed) {
+        return;
+    }
+
+    promise.setProgressValue(PROGRESS_RANGE);
+    promise.addResult(result);
+}
+
+void StatusImporter::onFinished() {
+    if (m_watcher.isCanceled() || m_watcher.future().resultCount() == 0) {
+        return;
+    }
+
+    ImportResult result = m_watcher.result();
+    if (!result.error.isEmpty()) {
+        qWarning() << result.error;
+        emit failed(result.error);
+        return;
+    }
+
+    // 一次性提交所有新增状态
+    m_statusManager->addStatuses(result.statuses);
+    emit finished(result.statuses.size(), result.duplicates, result.invalid);
+}
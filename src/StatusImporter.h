@@ -0,0 +1,94 @@
+#ifndef STATUSIMPORTER_H
+#define STATUSIMPORTER_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QIODevice>
+#include <QPromise>
+#include <QSet>
+#include <QVector>
+#include <QString>
+#include "StatusManager.h"
+
+/**
+ * @brief 批量导入器，从CSV或iCalendar(.ics)文件导入状态
+ *
+ * 文件在工作线程中逐行解析，与已有状态按图标、描述、起始时间、
+ * 持续时长去重后，一次性提交给 StatusManager。
+ */
+class StatusImporter : public QObject {
+    Q_OBJECT
+
+public:
+    enum Format {
+        Csv,
+        ICalendar
+    };
+
+    explicit StatusImporter(StatusManager *manager, QObject *parent = nullptr);
+
+    ~StatusImporter();
+
+    /**
+     * @brief 根据扩展名判断文件格式
+     */
+    static Format formatForFile(const QString &filePath);
+
+    /**
+     * @brief 同步解析CSV或iCalendar内容，不去重也不提交（可在工作线程中调用）
+     * @param invalid 输出无法解析的记录数
+     */
+    static QVector<StatusData> parse(QIODevice *device, Format format, int *invalid = nullptr);
+
+    /**
+     * @brief 开始导入，进行中时忽略
+     */
+    void start(const QString &filePath);
+
+    /**
+     * @brief 取消导入，已解析的记录不会提交
+     */
+    void cancel();
+
+    bool isRunning() const;
+
+signals:
+    /**
+     * @brief 导入进度（0-1000）
+     */
+    void progressChanged(int value);
+
+    /**
+     * @brief 导入完成
+     * @param imported 新增的状态数
+     * @param duplicates 跳过的重复记录数
+     * @param invalid 无法解析的记录数
+     */
+    void finished(int imported, int duplicates, int invalid);
+
+    void failed(const QString &message);
+
+private slots:
+    void onFinished();
+
+private:
+    /**
+     * @brief 工作线程的导入结果
+     */
+    struct ImportResult {
+        QVector<StatusData> statuses;
+        int duplicates = 0;
+        int invalid = 0;
+        QString error;
+    };
+
+    static void run(QPromise<ImportResult> &promise, const QString &filePath,
+                    const QVector<StatusData> &existing);
+
+    StatusManager *m_statusManager;
+    QFutureWatcher<ImportResult> m_watcher;
+
+    static const int PROGRESS_RANGE = 1000;
+};
+
+#endif // STATUSIMPORTER_H
@@ -1,134 +1,957 @@
 #include "StatusManager.h"
+#include "IsoTimestamp.h"
+#include <QCryptographicHash>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDebug>
+#include <QSet>
+#include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+#include <queue>
+
+namespace {
+    bool startsBefore(const StatusData &lhs, const StatusData &rhs) {
+        return lhs.startDateTime < rhs.startDateTime;
+    }
+
+    // 旧数据没有唯一标识时，由内容派生（各节点对同一文件得到相同标识）
+    const QUuid kLegacyUidNamespace(0x6f1c2a57, 0x3d4e, 0x4b8a, 0x9e, 0x21, 0x5a, 0x7c, 0x0d, 0x3f, 0x88, 0x14);
+
+    // 删除记录保留时长，超过后不再同步
+    const qint64 kTombstoneLifetimeMs = qint64(30) * 24 * 3600 * 1000;
+
+    QUuid legacyUid(const StatusData &status, int occurrence) {
+        QString key = status.icon + QChar(0x1f) + status.description + QChar(0x1f)
+                      + IsoTimestamp::format(status.startDateTime) + QChar(0x1f)
+                      + QString::number(status.durationHours);
+        if (occurrence > 0) {
+            key += QChar(0x1f) + QString::number(occurrence);
+        }
+        return QUuid::createUuidV5(kLegacyUidNamespace, key);
+    }
+
+    /**
+     * @brief 主数据源文件内容的摘要（不含摘要本身），用于识别文件是否被外部修改
+     */
+    QString journalDigest(QJsonObject root) {
+        root.remove("journalDigest");
+        return QString::fromLatin1(
+            QCryptographicHash::hash(QJsonDocument(root).toJson(QJsonDocument::Compact), QCryptographicHash::Sha1)
+                .toHex());
+    }
+
+    /**
+     * @brief 本地修改的时间戳，至少比被修改的版本晚1毫秒，避免时钟偏差使本地修改输给旧版本
+     */
+    qint64 localModificationTime(const StatusData &previous) {
+        return qMax(QDateTime::currentMSecsSinceEpoch(), previous.modifiedAt + 1);
+    }
+
+    /**
+     * @brief 冲突比较：修改时间晚者优先；相同时依次比较删除标记和内容，保证各节点结果一致
+     */
+    bool supersedes(const StatusChange &lhs, const StatusChange &rhs) {
+        const StatusData &a = lhs.status;
+        const StatusData &b = rhs.status;
+        if (a.modifiedAt != b.modifiedAt) return a.modifiedAt > b.modifiedAt;
+        if (lhs.deleted != rhs.deleted) return lhs.deleted;
+        if (a.icon != b.icon) return a.icon > b.icon;
+        if (a.description != b.description) return a.description > b.description;
+        if (a.startDateTime != b.startDateTime) return a.startDateTime > b.startDateTime;
+        if (a.durationHours != b.durationHours) return a.durationHours > b.durationHours;
+        return a.priority > b.priority;
+    }
+}
 
 StatusManager::StatusManager(QObject *parent)
     : QObject(parent)
+      , m_eventDeadline(-1)
+      , m_nodeId(QUuid::createUuid())
+      , m_journalEpoch(QUuid::createUuid())
+      , m_revision(0)
+      , m_loadWatcher(nullptr)
+      , m_loading(false)
 {
+    m_eventTimer = new QTimer(this);
+    m_eventTimer->setSingleShot(true);
+    m_eventTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_eventTimer, &QTimer::timeout, this, &StatusManager::dispatchEvents);
+    armEventTimer();
 }
 
 bool StatusManager::loadFromFile(const QString &filePath) {
-    m_filePath = filePath;
-    
+    m_sources.clear();
+    addSource(filePath);
+    return loadAllSources();
+}
+
+bool StatusManager::saveToFile(const QString &filePath) {
+    return writeSourceFile(0, filePath);
+}
+
+int StatusManager::addSource(const QString &filePath) {
+    int existing = findSource(filePath);
+    if (existing >= 0) {
+        return existing;
+    }
+
+    StatusSource source;
+    source.filePath = filePath;
+    m_sources.append(source);
+    return m_sources.size() - 1;
+}
+
+QStringList StatusManager::sourcePaths() const {
+    QStringList paths;
+    for (const StatusSource &source : m_sources) {
+        if (!source.filePath.isEmpty()) {
+            paths.append(source.filePath);
+        }
+    }
+    return paths;
+}
+
+bool StatusManager::loadAllSources() {
+    if (m_sources.isEmpty() || m_sources.first().filePath.isEmpty()) {
+        return false;
+    }
+
+    // 每个文件在线程池中独立读取和解析，总耗时约等于最大文件的耗时
+    const QList<SourceLoadResult> results =
+        QtConcurrent::blockingMapped<QList<SourceLoadResult>>(sourcePaths(), &StatusManager::readSourceFile);
+
+    bool ok = installLoadResults(results);
+    emit statusesChanged();
+    return ok;
+}
+
+void StatusManager::loadAllSourcesAsync() {
+    if (m_loading) {
+        return;
+    }
+    if (m_sources.isEmpty() || m_sources.first().filePath.isEmpty()) {
+        emit loadFinished(false);
+        return;
+    }
+
+    if (!m_loadWatcher) {
+        m_loadWatcher = new QFutureWatcher<SourceLoadResult>(this);
+        connect(m_loadWatcher, &QFutureWatcher<SourceLoadResult>::finished, this, [this]() {
+            bool ok = installLoadResults(m_loadWatcher->future().results());
+            m_loading = false;
+            emit statusesChanged();
+
+            // 执行加载期间排队的修改
+            const QVector<std::function<void()>> deferred = std::exchange(m_deferred, {});
+            for (const std::function<void()> &operation : deferred) {
+                operation();
+            }
+            emit loadFinished(ok);
+        });
+    }
+
+    m_loading = true;
+    m_loadWatcher->setFuture(QtConcurrent::mapped(sourcePaths(), &StatusManager::readSourceFile));
+}
+
+void StatusManager::setProvisionalStatuses(const QVector<StatusData> &statuses) {
+    // 只替换合并视图，数据源保持为空，不会被保存
+    m_statuses = statuses;
+    m_origins.clear();
+    resetTracking();
+    emit statusesChanged();
+}
+
+bool StatusManager::deferWhileLoading(std::function<void()> operation) {
+    if (!m_loading) {
+        return false;
+    }
+    m_deferred.append(std::move(operation));
+    return true;
+}
+
+bool StatusManager::installLoadResults(const QList<SourceLoadResult> &results) {
+    // 结果按文件数据源的顺序排列，跳过后台提供者的数据源
+    int resultIndex = 0;
+    for (int i = 0; i < m_sources.size(); ++i) {
+        if (m_sources[i].filePath.isEmpty()) {
+            continue;
+        }
+        const SourceLoadResult &result = results[resultIndex++];
+        if (result.ok) {
+            m_sources[i].statuses = result.statuses;
+        }
+    }
+
+    if (results.first().ok) {
+        installJournal(results.first());
+    }
+    rebuildPrimaryIndex();
+
+    rebuildMergedView();
+    resetTracking();
+    if (results.first().ok && results.first().journalEpoch.isNull()) {
+        // 换了新纪元，立即写回文件，下次启动沿用
+        saveSource(0);
+    }
+    return results.first().ok;
+}
+
+bool StatusManager::reloadSource(const QString &filePath) {
+    if (deferWhileLoading([this, filePath]() { reloadSource(filePath); })) {
+        return true;
+    }
+
+    int sourceIndex = findSource(filePath);
+    if (sourceIndex < 0) {
+        qWarning() << "未注册的数据源:" << filePath;
+        return false;
+    }
+
+    SourceLoadResult result = readSourceFile(filePath);
+    if (!result.ok) {
+        return false;
+    }
+
+    m_sources[sourceIndex].statuses = result.statuses;
+    if (sourceIndex == 0) {
+        installJournal(result);
+        rebuildPrimaryIndex();
+    }
+    rebuildMergedView();
+    resetTracking();
+    if (sourceIndex == 0 && result.journalEpoch.isNull()) {
+        saveSource(0);
+    }
+    emit statusesChanged();
+    return true;
+}
+
+StatusManager::SourceLoadResult StatusManager::readSourceFile(const QString &filePath) {
+    SourceLoadResult result;
+
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "无法打开文件:" << filePath;
-        return false;
+        return result;
     }
-    
+
     QByteArray data = file.readAll();
     file.close();
-    
+
     QJsonDocument doc = QJsonDocument::fromJson(data);
     if (!doc.isObject()) {
-        qWarning() << "JSON格式错误";
-        return false;
+        qWarning() << "JSON格式错误:" << filePath;
+        return result;
     }
-    
+
     QJsonObject root = doc.object();
     QJsonArray statusArray = root["statuses"].toArray();
-    
-    m_statuses.clear();
+
+    // 旧格式以加载当天为基准，整批只取一次当前日期
+    const QDate today = QDate::currentDate();
+
+    QSet<QUuid> seenUids;
+    QHash<QUuid, int> legacyOccurrences;
+
+    // 变更日志中的修订号及来源，校验通过后才使用
+    QVector<std::pair<quint64, JournalEntry>> entries;
+
+    result.statuses.reserve(statusArray.size());
     for (const QJsonValue &value : statusArray) {
         QJsonObject obj = value.toObject();
         StatusData status;
         status.icon = obj["icon"].toString();
         status.description = obj["description"].toString();
         status.durationHours = obj["durationHours"].toInt();
+        status.priority = obj["priority"].toInt();
 
         // 支持新格式（日期时间字符串）
         if (obj.contains("startDateTime")) {
-            status.startDateTime = QDateTime::fromString(
-                obj["startDateTime"].toString(), Qt::ISODate);
+            status.startDateTime = IsoTimestamp::parse(obj["startDateTime"].toString());
         }
         // 兼容旧格式（仅小时）
         else if (obj.contains("startHour")) {
             int startHour = obj["startHour"].toInt();
-            QDateTime now = QDateTime::currentDateTime();
-            status.startDateTime = QDateTime(now.date(), QTime(startHour, 0));
+            status.startDateTime = IsoTimestamp::fromLegacyHour(today, startHour);
+        }
+
+        status.modifiedAt = obj["modifiedAt"].toInteger();
+        status.uid = QUuid::fromString(obj["uid"].toString());
+        if (status.uid.isNull()) {
+            QUuid base = legacyUid(status, 0);
+            int occurrence = legacyOccurrences.value(base);
+            legacyOccurrences.insert(base, occurrence + 1);
+            status.uid = occurrence == 0 ? base : legacyUid(status, occurrence);
+        }
+        if (seenUids.contains(status.uid)) {
+            status.uid = QUuid::createUuid();
         }
+        seenUids.insert(status.uid);
 
-        m_statuses.append(status);
+        const quint64 revision = quint64(obj["revision"].toInteger());
+        if (revision > 0) {
+            entries.append({revision, {{status, QUuid::fromString(obj["origin"].toString()), false},
+                                       QUuid::fromString(obj["via"].toString())}});
+        }
+
+        result.statuses.append(status);
     }
 
-    emit statusesChanged();
-    return true;
+    // 删除记录（仅主数据源使用），过期的直接丢弃
+    const qint64 expiredBefore = QDateTime::currentMSecsSinceEpoch() - kTombstoneLifetimeMs;
+    for (const QJsonValue &value : root["tombstones"].toArray()) {
+        QJsonObject obj = value.toObject();
+        StatusChange tombstone;
+        tombstone.deleted = true;
+        tombstone.status.uid = QUuid::fromString(obj["uid"].toString());
+        tombstone.status.modifiedAt = obj["deletedAt"].toInteger();
+        tombstone.status.startDateTime = IsoTimestamp::parse(obj["startDateTime"].toString());
+        tombstone.origin = QUuid::fromString(obj["origin"].toString());
+        if (!tombstone.status.uid.isNull() && tombstone.status.modifiedAt >= expiredBefore) {
+            result.tombstones.append(tombstone);
+            const quint64 revision = quint64(obj["revision"].toInteger());
+            if (revision > 0) {
+                entries.append({revision, {tombstone, QUuid::fromString(obj["via"].toString())}});
+            }
+        }
+    }
+
+    // 文件由本程序保存且未被外部修改时沿用其变更日志，对端可以继续增量同步
+    const QUuid epoch = QUuid::fromString(root["journalEpoch"].toString());
+    if (!epoch.isNull() && root["journalDigest"].toString() == journalDigest(root)) {
+        result.journalEpoch = epoch;
+        result.revision = quint64(root["revision"].toInteger());
+        for (const auto &[revision, entry] : std::as_const(entries)) {
+            if (revision > result.revision || !result.journal.emplace(revision, entry).second) {
+                result.journalEpoch = QUuid();
+                result.revision = 0;
+                result.journal.clear();
+                break;
+            }
+        }
+    }
+
+    // 数据源内部按起始时间排序，供合并视图做k路归并
+    std::stable_sort(result.statuses.begin(), result.statuses.end(), startsBefore);
+
+    result.ok = true;
+    return result;
 }
 
-bool StatusManager::saveToFile(const QString &filePath) {
+bool StatusManager::writeSourceFile(int sourceIndex, const QString &filePath) const {
     QJsonArray statusArray;
 
-    for (const StatusData &status : m_statuses) {
-        QJsonObject obj;
-        obj["icon"] = status.icon;
-        obj["description"] = status.description;
-        obj["startDateTime"] = status.startDateTime.toString(Qt::ISODate);
-        obj["durationHours"] = status.durationHours;
-        statusArray.append(obj);
+    // 主数据源的每项附带其在变更日志中的修订号和来源
+    auto writeJournal = [this, sourceIndex](QJsonObject &obj, const QUuid &uid) {
+        auto revision = m_journalRevisions.constFind(uid);
+        if (sourceIndex != 0 || revision == m_journalRevisions.cend()) {
+            return;
+        }
+        const JournalEntry &entry = m_journal.at(*revision);
+        obj["revision"] = qint64(*revision);
+        if (!entry.change.origin.isNull()) {
+            obj["origin"] = entry.change.origin.toString(QUuid::WithoutBraces);
+        }
+        if (!entry.via.isNull()) {
+            obj["via"] = entry.via.toString(QUuid::WithoutBraces);
+        }
+    };
+
+    if (sourceIndex >= 0 && sourceIndex < m_sources.size()) {
+        for (const StatusData &status : m_sources[sourceIndex].statuses) {
+            QJsonObject obj;
+            obj["icon"] = status.icon;
+            obj["description"] = status.description;
+            obj["startDateTime"] = IsoTimestamp::format(status.startDateTime);
+            obj["durationHours"] = status.durationHours;
+            obj["priority"] = status.priority;
+            obj["uid"] = status.uid.toString(QUuid::WithoutBraces);
+            obj["modifiedAt"] = status.modifiedAt;
+            writeJournal(obj, status.uid);
+            statusArray.append(obj);
+        }
     }
-    
+
     QJsonObject root;
     root["statuses"] = statusArray;
-    
+
+    if (sourceIndex == 0 && !m_tombstones.isEmpty()) {
+        QJsonArray tombstoneArray;
+        for (const StatusChange &tombstone : m_tombstones) {
+            QJsonObject obj;
+            obj["uid"] = tombstone.status.uid.toString(QUuid::WithoutBraces);
+            obj["deletedAt"] = tombstone.status.modifiedAt;
+            obj["startDateTime"] = IsoTimestamp::format(tombstone.status.startDateTime);
+            if (!tombstone.origin.isNull()) {
+                obj["origin"] = tombstone.origin.toString(QUuid::WithoutBraces);
+            }
+            writeJournal(obj, tombstone.status.uid);
+            tombstoneArray.append(obj);
+        }
+        root["tombstones"] = tombstoneArray;
+    }
+
+    if (sourceIndex == 0) {
+        root["journalEpoch"] = m_journalEpoch.toString(QUuid::WithoutBraces);
+        root["revision"] = qint64(m_revision);
+        root["journalDigest"] = journalDigest(root);
+    }
+
     QJsonDocument doc(root);
-    
+
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly)) {
         qWarning() << "无法写入文件:" << filePath;
         return false;
     }
-    
+
     file.write(doc.toJson(QJsonDocument::Indented));
     file.close();
-    
+
     return true;
 }
 
+void StatusManager::saveSource(int sourceIndex) const {
+    const QString &filePath = m_sources[sourceIndex].filePath;
+    if (!filePath.isEmpty()) {
+        writeSourceFile(sourceIndex, filePath);
+    }
+}
+
+int StatusManager::findProviderSource(const QString &providerName) const {
+    for (int i = 0; i < m_sources.size(); ++i) {
+        if (m_sources[i].filePath.isEmpty() && m_sources[i].providerName == providerName) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int StatusManager::findSource(const QString &filePath) const {
+    for (int i = 0; i < m_sources.size(); ++i) {
+        if (m_sources[i].filePath == filePath) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void StatusManager::rebuildMergedView() {
+    // 归并游标：数据源序号 + 该数据源内的位置
+    struct Cursor {
+        int source;
+        int index;
+    };
+
+    // 小顶堆：起始时间早的优先，相同时按数据源注册顺序
+    auto later = [this](const Cursor &lhs, const Cursor &rhs) {
+        const StatusData &a = m_sources[lhs.source].statuses[lhs.index];
+        const StatusData &b = m_sources[rhs.source].statuses[rhs.index];
+        if (startsBefore(b, a)) return true;
+        if (startsBefore(a, b)) return false;
+        return lhs.source > rhs.source;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+
+    qsizetype total = 0;
+    for (int i = 0; i < m_sources.size(); ++i) {
+        total += m_sources[i].statuses.size();
+        if (!m_sources[i].statuses.isEmpty()) {
+            heap.push({i, 0});
+        }
+    }
+
+    m_statuses.clear();
+    m_origins.clear();
+    m_statuses.reserve(total);
+    m_origins.reserve(total);
+
+    while (!heap.empty()) {
+        Cursor cursor = heap.top();
+        heap.pop();
+
+        m_statuses.append(m_sources[cursor.source].statuses[cursor.index]);
+        m_origins.append({cursor.source, cursor.index});
+
+        if (++cursor.index < m_sources[cursor.source].statuses.size()) {
+            heap.push(cursor);
+        }
+    }
+}
+
 QVector<StatusData> StatusManager::getActiveStatuses() const {
     QVector<StatusData> active;
-    for (const StatusData &status : m_statuses) {
-        if (status.isActive()) {
-            active.append(status);
-        }
+    for (const StatusData &status : query().activeAt(QDateTime::currentDateTime()).view()) {
+        active.append(status);
     }
     return active;
 }
 
 QVector<StatusData> StatusManager::getExpiredStatuses() const {
     QVector<StatusData> expired;
-    for (const StatusData &status : m_statuses) {
-        if (status.isExpired()) {
-            expired.append(status);
-        }
+    for (const StatusData &status : query().expiredAt(QDateTime::currentDateTime()).view()) {
+        expired.append(status);
     }
     return expired;
 }
 
+QVector<StatusData> StatusManager::topActive(qsizetype k, qsizetype *activeCount) {
+    const QDateTime now = QDateTime::currentDateTime();
+    if (now.toSecsSinceEpoch() < m_ranking.currentSecs()) {
+        // 时钟回拨：已结束的状态可能重新有效，按合并视图重建
+        m_ranking.reset(m_statuses, now);
+    } else {
+        m_ranking.advance(now);
+    }
+
+    if (activeCount) {
+        *activeCount = m_ranking.activeCount();
+    }
+    return m_ranking.top(k);
+}
+
 void StatusManager::addStatus(const StatusData &status) {
-    m_statuses.append(status);
-    if (!m_filePath.isEmpty()) {
-        saveToFile(m_filePath);
+    if (deferWhileLoading([this, status]() { addStatus(status); })) {
+        return;
+    }
+
+    // 新状态写入主数据源
+    if (m_sources.isEmpty()) {
+        m_sources.append(StatusSource());
+    }
+
+    StatusData added = status;
+    if (added.uid.isNull() || m_primaryStarts.contains(added.uid)) {
+        added.uid = QUuid::createUuid();
+    }
+    added.modifiedAt = QDateTime::currentMSecsSinceEpoch();
+    insertPrimary(added);
+    m_tombstones.remove(added.uid);
+    recordChange({added, m_nodeId, false}, m_nodeId);
+
+    rebuildMergedView();
+    saveSource(0);
+    emit statusesChanged();
+}
+
+void StatusManager::addStatuses(const QVector<StatusData> &statuses) {
+    if (statuses.isEmpty()) {
+        return;
+    }
+    if (deferWhileLoading([this, statuses]() { addStatuses(statuses); })) {
+        return;
     }
+    if (m_sources.isEmpty()) {
+        m_sources.append(StatusSource());
+    }
+
+    // 新批次排序后与主数据源归并，保持按起始时间有序
+    QVector<StatusData> &target = m_sources[0].statuses;
+    qsizetype oldSize = target.size();
+    target.append(statuses);
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (qsizetype i = oldSize; i < target.size(); ++i) {
+        StatusData &added = target[i];
+        if (added.uid.isNull() || m_primaryStarts.contains(added.uid)) {
+            added.uid = QUuid::createUuid();
+        }
+        added.modifiedAt = now;
+        m_primaryStarts.insert(added.uid, added.startDateTime);
+        track(added);
+        m_tombstones.remove(added.uid);
+        recordChange({added, m_nodeId, false}, m_nodeId);
+    }
+
+    std::stable_sort(target.begin() + oldSize, target.end(), startsBefore);
+    std::inplace_merge(target.begin(), target.begin() + oldSize, target.end(), startsBefore);
+
+    rebuildMergedView();
+    saveSource(0);
     emit statusesChanged();
 }
 
 void StatusManager::removeStatus(int index) {
+    if (m_loading) {
+        // 临时视图没有数据源位置，加载完成后按唯一标识重新定位
+        if (index >= 0 && index < m_statuses.size()) {
+            removeStatus(m_statuses[index].uid);
+        }
+        return;
+    }
+
     if (index >= 0 && index < m_statuses.size()) {
-        m_statuses.remove(index);
-        if (!m_filePath.isEmpty()) {
-            saveToFile(m_filePath);
+        StatusOrigin origin = m_origins[index];
+        if (!m_sources[origin.source].providerName.isEmpty()) {
+            qWarning() << "后台提供者生成的状态不能删除:" << m_sources[origin.source].providerName;
+            return;
+        }
+        if (origin.source == 0) {
+            StatusChange tombstone{m_statuses[index], m_nodeId, true};
+            tombstone.status.modifiedAt = localModificationTime(tombstone.status);
+            m_primaryStarts.remove(tombstone.status.uid);
+            m_tombstones.insert(tombstone.status.uid, tombstone);
+            recordChange(tombstone, m_nodeId);
+        }
+        untrack(m_statuses[index]);
+        m_sources[origin.source].statuses.remove(origin.index);
+
+        rebuildMergedView();
+        saveSource(origin.source);
+        emit statusesChanged();
+    }
+}
+
+void StatusManager::removeStatus(const QUuid &uid) {
+    if (deferWhileLoading([this, uid]() { removeStatus(uid); })) {
+        return;
+    }
+    int index = findStatus(uid);
+    if (index >= 0) {
+        removeStatus(index);
+    }
+}
+
+QString StatusManager::providerOf(const QUuid &uid) const {
+    if (m_loading) {
+        return QString();
+    }
+    int index = findStatus(uid);
+    if (index < 0 || index >= m_origins.size()) {
+        return QString();
+    }
+    return m_sources[m_origins[index].source].providerName;
+}
+
+int StatusManager::findStatus(const QUuid &uid) const {
+    auto it = std::find_if(m_statuses.cbegin(), m_statuses.cend(),
+                           [&uid](const StatusData &status) { return status.uid == uid; });
+    return it != m_statuses.cend() ? static_cast<int>(it - m_statuses.cbegin()) : -1;
+}
+
+void StatusManager::applyProviderDiffs(const QHash<QString, ProviderDiff> &diffs) {
+    if (deferWhileLoading([this, diffs]() { applyProviderDiffs(diffs); })) {
+        return;
+    }
+    if (m_sources.isEmpty()) {
+        m_sources.append(StatusSource());
+    }
+
+    bool changed = false;
+    for (auto it = diffs.cbegin(); it != diffs.cend(); ++it) {
+        const ProviderDiff &diff = it.value();
+        if (diff.added.isEmpty() && diff.removed.isEmpty()) {
+            continue;
+        }
+
+        int sourceIndex = findProviderSource(it.key());
+        if (sourceIndex < 0) {
+            StatusSource source;
+            source.providerName = it.key();
+            m_sources.append(source);
+            sourceIndex = m_sources.size() - 1;
+        }
+        QVector<StatusData> &statuses = m_sources[sourceIndex].statuses;
+
+        // 按内容（含优先级）删除，相同内容出现多次时逐个抵消
+        if (!diff.removed.isEmpty()) {
+            QHash<PrioritizedStatus, int> pending;
+            for (const StatusData &status : diff.removed) {
+                ++pending[PrioritizedStatus{status}];
+            }
+            statuses.removeIf([this, &pending](const StatusData &status) {
+                auto found = pending.find(PrioritizedStatus{status});
+                if (found == pending.end() || *found == 0) {
+                    return false;
+                }
+                --*found;
+                untrack(status);
+                return true;
+            });
+        }
+
+        // 新增部分排序后归并，保持按起始时间有序
+        if (!diff.added.isEmpty()) {
+            qsizetype oldSize = statuses.size();
+            statuses.append(diff.added);
+            for (qsizetype i = oldSize; i < statuses.size(); ++i) {
+                if (statuses[i].uid.isNull()) {
+                    statuses[i].uid = QUuid::createUuid();
+                }
+                track(statuses[i]);
+            }
+            std::stable_sort(statuses.begin() + oldSize, statuses.end(), startsBefore);
+            std::inplace_merge(statuses.begin(), statuses.begin() + oldSize, statuses.end(), startsBefore);
         }
+        changed = true;
+    }
+
+    if (changed) {
+        rebuildMergedView();
         emit statusesChanged();
     }
 }
 
 void StatusManager::clearAll() {
-    m_statuses.clear();
-    if (!m_filePath.isEmpty()) {
-        saveToFile(m_filePath);
+    if (deferWhileLoading([this]() { clearAll(); })) {
+        return;
     }
+
+    if (!m_sources.isEmpty()) {
+        for (const StatusData &status : std::as_const(m_sources[0].statuses)) {
+            StatusChange tombstone{status, m_nodeId, true};
+            tombstone.status.modifiedAt = localModificationTime(status);
+            m_tombstones.insert(status.uid, tombstone);
+            recordChange(tombstone, m_nodeId);
+        }
+    }
+    m_primaryStarts.clear();
+
+    // 与新增一样只作用于主数据源：附加数据源（团队文件、sources目录）是共享文件，
+    // 后台提供者的状态不属于用户数据，都保留
+    if (!m_sources.isEmpty()) {
+        m_sources[0].statuses.clear();
+        saveSource(0);
+    }
+    rebuildMergedView();
+    resetTracking();
     emit statusesChanged();
-}
\ No newline at end of file
+}
+
+QVector<StatusChange> StatusManager::changesSince(const QUuid &epoch, quint64 revision,
+                                                  const QUuid &excludePeer, bool *full) const {
+    QVector<StatusChange> changes;
+
+    // 对端的修订号属于旧纪元（主数据源文件被外部修改）时只能完整同步
+    const bool fullSync = epoch != m_journalEpoch || revision == 0 || revision > m_revision;
+    if (full) {
+        *full = fullSync;
+    }
+
+    if (fullSync) {
+        if (!m_sources.isEmpty()) {
+            changes.reserve(m_sources[0].statuses.size() + m_tombstones.size());
+            for (const StatusData &status : m_sources[0].statuses) {
+                changes.append({status, m_nodeId, false});
+            }
+        }
+        for (const StatusChange &tombstone : m_tombstones) {
+            changes.append(tombstone);
+        }
+        return changes;
+    }
+
+    for (auto it = m_journal.upper_bound(revision); it != m_journal.end(); ++it) {
+        const JournalEntry &entry = it->second;
+        if (!excludePeer.isNull() && (entry.via == excludePeer || entry.change.origin == excludePeer)) {
+            continue;
+        }
+        changes.append(entry.change);
+    }
+    return changes;
+}
+
+int StatusManager::applyChanges(const QVector<StatusChange> &changes, const QUuid &via) {
+    if (deferWhileLoading([this, changes, via]() { applyChanges(changes, via); })) {
+        return 0;
+    }
+    if (m_sources.isEmpty()) {
+        m_sources.append(StatusSource());
+    }
+
+    int applied = 0;
+    for (const StatusChange &change : changes) {
+        const QUuid &uid = change.status.uid;
+        if (uid.isNull()) {
+            continue;
+        }
+
+        // 本机当前版本：现存状态或删除记录
+        int index = findPrimary(uid);
+        if (index >= 0) {
+            const StatusChange current{m_sources[0].statuses[index], QUuid(), false};
+            if (!supersedes(change, current)) {
+                continue;
+            }
+            m_primaryStarts.remove(uid);
+            untrack(m_sources[0].statuses[index]);
+            m_sources[0].statuses.remove(index);
+        } else {
+            auto tombstone = m_tombstones.constFind(uid);
+            if (tombstone != m_tombstones.cend() && !supersedes(change, *tombstone)) {
+                continue;
+            }
+        }
+
+        if (change.deleted) {
+            m_tombstones.insert(uid, change);
+        } else {
+            m_tombstones.remove(uid);
+            insertPrimary(change.status);
+        }
+        recordChange(change, via);
+        ++applied;
+    }
+
+    if (applied > 0) {
+        rebuildMergedView();
+        saveSource(0);
+        emit statusesChanged();
+    }
+    return applied;
+}
+
+QVector<StatusData> &StatusManager::primaryStatuses() {
+    if (m_sources.isEmpty()) {
+        m_sources.append(StatusSource());
+    }
+    return m_sources[0].statuses;
+}
+
+void StatusManager::insertPrimary(const StatusData &status) {
+    QVector<StatusData> &statuses = primaryStatuses();
+    auto pos = std::upper_bound(statuses.begin(), statuses.end(), status, startsBefore);
+    statuses.insert(pos, status);
+    m_primaryStarts.insert(status.uid, status.startDateTime);
+    track(status);
+}
+
+int StatusManager::findPrimary(const QUuid &uid) const {
+    auto start = m_primaryStarts.constFind(uid);
+    if (start == m_primaryStarts.cend() || m_sources.isEmpty()) {
+        return -1;
+    }
+
+    // 主数据源按起始时间排序，先二分定位再在同一时刻的状态中查找
+    const QVector<StatusData> &statuses = m_sources[0].statuses;
+    auto first = std::partition_point(statuses.cbegin(), statuses.cend(),
+                                      [&start](const StatusData &status) {
+                                          return status.startDateTime < *start;
+                                      });
+    for (auto it = first; it != statuses.cend() && it->startDateTime == *start; ++it) {
+        if (it->uid == uid) {
+            return it - statuses.cbegin();
+        }
+    }
+    return -1;
+}
+
+void StatusManager::rebuildPrimaryIndex() {
+    m_primaryStarts.clear();
+    if (m_sources.isEmpty()) {
+        return;
+    }
+    m_primaryStarts.reserve(m_sources[0].statuses.size());
+    for (const StatusData &status : m_sources[0].statuses) {
+        m_primaryStarts.insert(status.uid, status.startDateTime);
+    }
+}
+
+void StatusManager::recordChange(const StatusChange &change, const QUuid &via) {
+    // 每个标识只保留最新一条，日志大小不超过状态与删除记录总数
+    auto previous = m_journalRevisions.constFind(change.status.uid);
+    if (previous != m_journalRevisions.cend()) {
+        m_journal.erase(*previous);
+    }
+    ++m_revision;
+    m_journal[m_revision] = {change, via};
+    m_journalRevisions.insert(change.status.uid, m_revision);
+}
+
+void StatusManager::resetTracking() {
+    const QDateTime now = QDateTime::currentDateTime();
+    m_ranking.reset(m_statuses, now);
+    m_events.reset(m_statuses, now.toSecsSinceEpoch());
+    armEventTimer();
+}
+
+void StatusManager::track(const StatusData &status) {
+    m_ranking.insert(status);
+    m_events.insert(status);
+
+    // 新事件早于当前定时时间时提前唤醒
+    const qint64 wake = m_events.nextWakeup();
+    if (wake >= 0 && wake < m_eventDeadline) {
+        armEventTimer();
+    }
+}
+
+void StatusManager::untrack(const StatusData &status) {
+    m_ranking.remove(status);
+    m_events.remove(status);
+}
+
+void StatusManager::setReminderMinutes(int minutes) {
+    m_events.setReminderLead(qMax(0, minutes) * qint64(60));
+    resetTracking();
+}
+
+void StatusManager::armEventTimer() {
+    // 即使没有事件也定期唤醒，以便发现时钟调整
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    qint64 deadline = nowMs / 1000 + EVENT_HEARTBEAT;
+    const qint64 wake = m_events.nextWakeup();
+    if (wake >= 0 && wake < deadline) {
+        deadline = wake;
+    }
+    m_eventDeadline = deadline;
+    m_eventTimer->start(static_cast<int>(qBound(qint64(0), deadline * 1000 - nowMs, qint64(EVENT_HEARTBEAT) * 1000)));
+}
+
+void StatusManager::dispatchEvents() {
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    if (now < m_events.currentSecs()) {
+        // 时钟回拨：按合并视图重新安排，回拨区间内的事件会再次发生
+        resetTracking();
+        return;
+    }
+
+    // 休眠或时钟前调后一次补齐期间的全部事件
+    QVector<StatusEvent> fired;
+    m_events.advance(now, fired);
+    armEventTimer();
+
+    const int reminderMinutes = static_cast<int>(m_events.reminderLead() / 60);
+    for (const StatusEvent &event : std::as_const(fired)) {
+        switch (event.type) {
+            case StatusEvent::Reminder:
+                emit statusReminder(event.status, reminderMinutes);
+                break;
+            case StatusEvent::Start:
+                emit statusStarted(event.status);
+                break;
+            case StatusEvent::End:
+                emit statusEnded(event.status);
+                break;
+        }
+    }
+}
+
+void StatusManager::installJournal(const SourceLoadResult &result) {
+    resetJournal();
+    for (const StatusChange &tombstone : result.tombstones) {
+        m_tombstones.insert(tombstone.status.uid, tombstone);
+    }
+    if (result.journalEpoch.isNull()) {
+        return;
+    }
+
+    m_journalEpoch = result.journalEpoch;
+    m_revision = result.revision;
+    m_journal = result.journal;
+    for (const auto &[revision, entry] : m_journal) {
+        m_journalRevisions.insert(entry.change.status.uid, revision);
+    }
+}
+
+void StatusManager::resetJournal() {
+    m_journal.clear();
+    m_journalRevisions.clear();
+    m_tombstones.clear();
+    m_journalEpoch = QUuid::createUuid();
+    m_revision = 0;
+}
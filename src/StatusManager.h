@@ -4,10 +4,42 @@
 #include <QObject>
 #include <QVector>
 #include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QUuid>
+#include <QFutureWatcher>
+#include <functional>
+#include <map>
 #include "StatusData.h"
+#include "StatusQuery.h"
+#include "ActiveRanking.h"
+#include "StatusEventSchedule.h"
+
+class QTimer;
+
+/**
+ * @brief 一条同步变更：新增的状态或删除记录
+ */
+struct StatusChange {
+    StatusData status; // 状态内容（删除时为最后已知内容，modifiedAt 为删除时间）
+    QUuid origin; // 最初产生该变更的节点
+    bool deleted = false;
+};
+
+/**
+ * @brief 后台提供者一次轮询相对上一次结果的增量
+ */
+struct ProviderDiff {
+    QVector<StatusData> added;
+    QVector<StatusData> removed;
+};
 
 /**
  * @brief 状态管理器，负责状态数据的读写和管理
+ *
+ * 支持注册多个数据源（个人文件、团队文件、生成的日程文件等），
+ * 各数据源并行加载，并按起始时间合并为一个有序视图。
+ * 第一个注册的数据源为主数据源，新添加的状态写入主数据源。
  */
 class StatusManager : public QObject {
     Q_OBJECT
@@ -16,54 +48,344 @@ public:
     explicit StatusManager(QObject *parent = nullptr);
 
     /**
-     * @brief 从JSON文件加载状态数据
+     * @brief 从JSON文件加载状态数据（仅使用该文件作为唯一数据源）
      */
     bool loadFromFile(const QString &filePath);
 
     /**
-     * @brief 保存状态数据到JSON文件
+     * @brief 保存主数据源到JSON文件
      */
     bool saveToFile(const QString &filePath);
 
     /**
-     * @brief 获取所有状态
+     * @brief 注册数据源（不立即加载），重复注册同一路径无效
+     * @return 数据源序号
+     */
+    int addSource(const QString &filePath);
+
+    /**
+     * @brief 获取已注册的数据源路径
+     */
+    QStringList sourcePaths() const;
+
+    /**
+     * @brief 并行加载所有已注册的数据源
+     * @return 主数据源是否加载成功
+     */
+    bool loadAllSources();
+
+    /**
+     * @brief 在后台并行加载所有数据源，完成后替换当前数据并发出 loadFinished
+     *
+     * 加载期间的修改操作会排队，加载完成后按顺序执行。
+     */
+    void loadAllSourcesAsync();
+
+    /**
+     * @brief 是否正在后台加载
+     */
+    bool isLoading() const { return m_loading; }
+
+    /**
+     * @brief 在完整数据加载前临时显示的状态（如启动快照），只读，加载完成后被替换
+     */
+    void setProvisionalStatuses(const QVector<StatusData> &statuses);
+
+    /**
+     * @brief 单独重新加载某个数据源，其他数据源不受影响
+     */
+    bool reloadSource(const QString &filePath);
+
+    /**
+     * @brief 获取所有状态（按起始时间排序的合并视图）
      */
     QVector<StatusData> getAllStatuses() const { return m_statuses; }
 
     /**
-     * @brief 获取当前有效的状态
+     * @brief 在合并视图上构造惰性查询，不复制数据
+     */
+    StatusQuery query() const { return StatusQuery(m_statuses); }
+
+    /**
+     * @brief 获取当前有效的状态（复制结果，频繁调用请使用 query()）
      */
     QVector<StatusData> getActiveStatuses() const;
 
     /**
-     * @brief 获取已过期的状态
+     * @brief 获取已过期的状态（复制结果，频繁调用请使用 query()）
      */
     QVector<StatusData> getExpiredStatuses() const;
 
+    /**
+     * @brief 按排名取前 k 个当前有效的状态（k < 0 表示全部）
+     *
+     * 排名：优先级高的在前，其次先结束的，再次最近开始的。排名增量维护，
+     * 每次状态增删或开始、结束为 O(log n)，本函数为 O(k)。增删本身仍要重建合并视图，
+     * 为 O(n)（见 rebuildMergedView），排名只省去了每次刷新时对全部有效状态的排序。
+     * @param activeCount 输出当前有效状态总数
+     */
+    QVector<StatusData> topActive(qsizetype k, qsizetype *activeCount = nullptr);
+
+    /**
+     * @brief 设置开始前提醒的提前分钟数，0表示不提醒
+     */
+    void setReminderMinutes(int minutes);
+
+    int reminderMinutes() const { return static_cast<int>(m_events.reminderLead() / 60); }
+
+    /**
+     * @brief 尚未发生的提醒、开始、结束事件数
+     */
+    qsizetype pendingEventCount() const { return m_events.pendingCount(); }
+
     /**
      * @brief 添加新状态
      */
     void addStatus(const StatusData &status);
 
     /**
-     * @brief 删除指定索引的状态
+     * @brief 批量添加状态，只保存一次并只发出一次变化信号
+     */
+    void addStatuses(const QVector<StatusData> &statuses);
+
+    /**
+     * @brief 删除指定索引的状态，后台提供者生成的状态不能删除
      */
     void removeStatus(int index);
 
     /**
-     * @brief 清空所有状态
+     * @brief 按唯一标识删除状态，不受其间其他增删造成的索引变化影响；不存在时忽略
+     */
+    void removeStatus(const QUuid &uid);
+
+    /**
+     * @brief 指定状态由后台提供者生成时返回提供者名称，否则返回空
+     *
+     * 提供者生成的状态只在内存中，删除后会在下一次轮询时重新出现，需在其数据来源中删除。
+     */
+    QString providerOf(const QUuid &uid) const;
+
+    /**
+     * @brief 清空主数据源中的所有状态，附加数据源和后台提供者的状态保留
      */
     void clearAll();
 
+    /**
+     * @brief 批量应用后台提供者的增量（键为提供者名称），只发出一次变化信号
+     *
+     * 提供者的状态保存在各自的内存数据源中，参与合并视图但不写入文件，也不参与同步。
+     */
+    void applyProviderDiffs(const QHash<QString, ProviderDiff> &diffs);
+
+    /**
+     * @brief 设置本机节点标识，本地产生的变更以此为来源
+     */
+    void setNodeId(const QUuid &nodeId) { m_nodeId = nodeId; }
+
+    QUuid nodeId() const { return m_nodeId; }
+
+    /**
+     * @brief 变更日志的纪元，随主数据源保存；文件被外部修改后改变，对端需要完整同步
+     */
+    QUuid journalEpoch() const { return m_journalEpoch; }
+
+    /**
+     * @brief 当前修订号，主数据源每次变更加一
+     */
+    quint64 revision() const { return m_revision; }
+
+    /**
+     * @brief 获取指定修订号之后的主数据源变更
+     *
+     * 纪元不一致或修订号为0时返回主数据源的完整状态（含删除记录）。
+     * @param excludePeer 跳过由该节点产生或从该节点收到的变更
+     * @param full 输出是否为完整状态
+     */
+    QVector<StatusChange> changesSince(const QUuid &epoch, quint64 revision,
+                                       const QUuid &excludePeer, bool *full = nullptr) const;
+
+    /**
+     * @brief 应用对端的变更，按修改时间后写入者优先，结果确定且与应用顺序无关
+     * @param via 变更来自的节点
+     * @return 实际生效的变更数
+     */
+    int applyChanges(const QVector<StatusChange> &changes, const QUuid &via);
+
     signals:
         /**
          * @brief 状态数据变化信号
          */
         void statusesChanged();
 
+        /**
+         * @brief 后台加载完成信号
+         * @param ok 主数据源是否加载成功
+         */
+        void loadFinished(bool ok);
+
+        /**
+         * @brief 状态即将开始（提前 minutesBefore 分钟）
+         */
+        void statusReminder(const StatusData &status, int minutesBefore);
+
+        /**
+         * @brief 状态开始
+         */
+        void statusStarted(const StatusData &status);
+
+        /**
+         * @brief 状态结束
+         */
+        void statusEnded(const StatusData &status);
+
 private:
+    /**
+     * @brief 数据源：一个JSON文件及其中的状态（按起始时间排序）
+     */
+    struct StatusSource {
+        QString filePath;     // 后台提供者的数据源为空
+        QString providerName;
+        QVector<StatusData> statuses;
+    };
+
+    /**
+     * @brief 合并视图中每一项对应的数据源位置
+     */
+    struct StatusOrigin {
+        int source;
+        int index;
+    };
+
+    /**
+     * @brief 变更日志中的一项
+     */
+    struct JournalEntry {
+        StatusChange change;
+        QUuid via;
+    };
+
+    /**
+     * @brief 单个文件的读取结果（在工作线程中生成）
+     *
+     * 文件中保存的变更日志校验通过时 journalEpoch 非空，否则需要换新纪元。
+     */
+    struct SourceLoadResult {
+        bool ok = false;
+        QVector<StatusData> statuses;
+        QVector<StatusChange> tombstones;
+        QUuid journalEpoch;
+        quint64 revision = 0;
+        std::map<quint64, JournalEntry> journal;
+    };
+
+    static SourceLoadResult readSourceFile(const QString &filePath);
+
+    /**
+     * @brief 用各文件的读取结果替换数据源内容
+     * @return 主数据源是否读取成功
+     */
+    bool installLoadResults(const QList<SourceLoadResult> &results);
+
+    /**
+     * @brief 加载期间推迟修改操作
+     * @return 是否已推迟
+     */
+    bool deferWhileLoading(std::function<void()> operation);
+
+    bool writeSourceFile(int sourceIndex, const QString &filePath) const;
+
+    void saveSource(int sourceIndex) const;
+
+    int findSource(const QString &filePath) const;
+
+    int findProviderSource(const QString &providerName) const;
+
+    /**
+     * @brief 对各数据源做k路归并，重建合并视图
+     *
+     * 每次增删都整体重建，为 O(n log 数据源数)。合并视图中的位置 m_origins 指向各数据源内的下标，
+     * 插入或删除后其后的下标都会变化，逐项更新同样是 O(n)，所以不做增量维护。
+     */
+    void rebuildMergedView();
+
+    QVector<StatusData> &primaryStatuses();
+
+    /**
+     * @brief 将状态按起始时间插入主数据源
+     */
+    void insertPrimary(const StatusData &status);
+
+    /**
+     * @brief 在主数据源中按唯一标识查找状态
+     */
+    int findPrimary(const QUuid &uid) const;
+
+    /**
+     * @brief 在合并视图中按唯一标识查找状态，O(n)
+     */
+    int findStatus(const QUuid &uid) const;
+
+    void rebuildPrimaryIndex();
+
+    /**
+     * @brief 记录主数据源的一条变更
+     */
+    void recordChange(const StatusChange &change, const QUuid &via);
+
+    /**
+     * @brief 用主数据源的读取结果恢复删除记录和变更日志，没有可用的日志时换新纪元
+     */
+    void installJournal(const SourceLoadResult &result);
+
+    void resetJournal();
+
+    /**
+     * @brief 按合并视图重建排名和事件（加载、清空等整体变化后调用）
+     */
+    void resetTracking();
+
+    /**
+     * @brief 单个状态加入或移出排名和事件
+     */
+    void track(const StatusData &status);
+
+    void untrack(const StatusData &status);
+
+    /**
+     * @brief 定时到下一个事件，最长 EVENT_HEARTBEAT 秒
+     */
+    void armEventTimer();
+
+    /**
+     * @brief 处理到期的事件并发出相应信号
+     */
+    void dispatchEvents();
+
+    QVector<StatusSource> m_sources;
     QVector<StatusData> m_statuses;
-    QString m_filePath;
+    QVector<StatusOrigin> m_origins;
+    ActiveRanking m_ranking;
+
+    // 提醒、开始、结束事件
+    StatusEventSchedule m_events;
+    QTimer *m_eventTimer;
+    qint64 m_eventDeadline; // 事件定时器的到期时间（UTC秒）
+
+    // 同步：主数据源的标识索引、删除记录与变更日志
+    QHash<QUuid, QDateTime> m_primaryStarts;
+    QHash<QUuid, StatusChange> m_tombstones;
+    std::map<quint64, JournalEntry> m_journal;
+    QHash<QUuid, quint64> m_journalRevisions;
+    QUuid m_nodeId;
+    QUuid m_journalEpoch;
+    quint64 m_revision;
+
+    // 后台加载
+    QFutureWatcher<SourceLoadResult> *m_loadWatcher;
+    bool m_loading;
+    QVector<std::function<void()>> m_deferred;
+
+    static const int EVENT_HEARTBEAT = 60; // 事件定时器的最长间隔（秒）
 };
 
-#endif // STATUSMANAGER_H
\ No newline at end of file
+#endif // STATUSMANAGER_H
@@ -0,0 +1,76 @@
+#ifndef STATUSPROVIDER_H
+#define STATUSPROVIDER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "StatusData.h"
+
+/**
+ * @brief 一次轮询的结果
+ */
+struct ProviderResult {
+    bool ok = false;
+    QVector<StatusData> statuses; // 该提供者当前给出的全部状态
+    QString error;
+};
+
+/**
+ * @brief 后台状态提供者接口（日历导出文件、命令输出、监视目录等）
+ *
+ * poll() 在 ProviderScheduler 的工作线程中调用，同一提供者同一时刻最多
+ * 只有一次调用；实现不得访问界面或 StatusManager。每次返回完整结果，
+ * 由调度器与上一次结果比较后以增量方式合并。
+ */
+class StatusProvider {
+public:
+    explicit StatusProvider(const QString &name)
+        : m_name(name)
+          , m_pollInterval(60 * 1000)
+          , m_minimumInterval(5 * 1000)
+          , m_timeout(30 * 1000) {
+    }
+
+    virtual ~StatusProvider() = default;
+
+    QString name() const { return m_name; }
+
+    /**
+     * @brief 定期轮询间隔（毫秒），0 表示只在监视的路径变化时轮询
+     */
+    int pollInterval() const { return m_pollInterval; }
+
+    void setPollInterval(int msecs) { m_pollInterval = qMax(0, msecs); }
+
+    /**
+     * @brief 两次轮询开始之间的最小间隔（毫秒），期间的触发合并为一次
+     */
+    int minimumInterval() const { return m_minimumInterval; }
+
+    void setMinimumInterval(int msecs) { m_minimumInterval = qMax(0, msecs); }
+
+    /**
+     * @brief 单次轮询超时（毫秒），超时后不再占用线程池名额
+     */
+    int timeout() const { return m_timeout; }
+
+    void setTimeout(int msecs) { m_timeout = qMax(1, msecs); }
+
+    /**
+     * @brief 变化时立即触发轮询的文件或目录
+     */
+    virtual QStringList watchedPaths() const { return {}; }
+
+    /**
+     * @brief 获取当前状态（工作线程中调用）
+     */
+    virtual ProviderResult poll() = 0;
+
+private:
+    QString m_name;
+    int m_pollInterval;
+    int m_minimumInterval;
+    int m_timeout;
+};
+
+#endif // STATUSPROVIDER_H
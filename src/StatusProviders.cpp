@@ -0,0 +1,86 @@
+#include "StatusProviders.h"
+#include "StatusImporter.h"
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+
+namespace {
+    bool readStatusFile(const QString &filePath, ProviderResult &result) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            result.error = "无法打开文件：" + filePath;
+            return false;
+        }
+        result.statuses += StatusImporter::parse(&file, StatusImporter::formatForFile(filePath));
+        return true;
+    }
+}
+
+CalendarFileProvider::CalendarFileProvider(const QString &name, const QString &filePath)
+    : StatusProvider(name)
+      , m_filePath(filePath) {
+}
+
+ProviderResult CalendarFileProvider::poll() {
+    ProviderResult result;
+    result.ok = readStatusFile(m_filePath, result);
+    return result;
+}
+
+CommandProvider::CommandProvider(const QString &name, const QString &program, const QStringList &arguments)
+    : StatusProvider(name)
+      , m_program(program)
+      , m_arguments(arguments) {
+}
+
+ProviderResult CommandProvider::poll() {
+    ProviderResult result;
+
+    // 在工作线程中同步等待，不需要事件循环
+    QProcess process;
+    process.start(m_program, m_arguments, QIODevice::ReadOnly);
+    if (!process.waitForStarted()) {
+        result.error = "无法启动命令：" + m_program;
+        return result;
+    }
+    if (!process.waitForFinished(timeout())) {
+        process.kill();
+        process.waitForFinished();
+        result.error = "命令超时：" + m_program;
+        return result;
+    }
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+        result.error = QString("命令失败（退出码 %1）：%2").arg(process.exitCode()).arg(m_program);
+        return result;
+    }
+
+    QByteArray output = process.readAllStandardOutput();
+    QBuffer buffer(&output);
+    buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+    result.statuses = StatusImporter::parse(&buffer, StatusImporter::Csv);
+    result.ok = true;
+    return result;
+}
+
+DirectoryProvider::DirectoryProvider(const QString &name, const QString &dirPath)
+    : StatusProvider(name)
+      , m_dirPath(dirPath) {
+}
+
+ProviderResult DirectoryProvider::poll() {
+    ProviderResult result;
+    QDir dir(m_dirPath);
+    if (!dir.exists()) {
+        result.error = "目录不存在：" + m_dirPath;
+        return result;
+    }
+
+    // 单个文件读取失败不影响其他文件
+    const QStringList files = dir.entryList({"*.ics", "*.ical", "*.csv"}, QDir::Files, QDir::Name);
+    for (const QString &fileName : files) {
+        readStatusFile(dir.filePath(fileName), result);
+    }
+    result.ok = true;
+    return result;
+}
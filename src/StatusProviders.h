@@ -0,0 +1,51 @@
+#ifndef STATUSPROVIDERS_H
+#define STATUSPROVIDERS_H
+
+#include "StatusProvider.h"
+
+/**
+ * @brief 日历导出文件（.ics）或CSV文件，文件变化时重新读取
+ */
+class CalendarFileProvider : public StatusProvider {
+public:
+    CalendarFileProvider(const QString &name, const QString &filePath);
+
+    QStringList watchedPaths() const override { return {m_filePath}; }
+
+    ProviderResult poll() override;
+
+private:
+    QString m_filePath;
+};
+
+/**
+ * @brief 定期运行命令，标准输出为与批量导入相同的CSV格式
+ *        （图标,描述,起始时间,持续小时数）
+ */
+class CommandProvider : public StatusProvider {
+public:
+    CommandProvider(const QString &name, const QString &program, const QStringList &arguments);
+
+    ProviderResult poll() override;
+
+private:
+    QString m_program;
+    QStringList m_arguments;
+};
+
+/**
+ * @brief 监视目录，读取其中所有 .ics/.csv 文件
+ */
+class DirectoryProvider : public StatusProvider {
+public:
+    DirectoryProvider(const QString &name, const QString &dirPath);
+
+    QStringList watchedPaths() const override { return {m_dirPath}; }
+
+    ProviderResult poll() override;
+
+private:
+    QString m_dirPath;
+};
+
+#endif // STATUSPROVIDERS_H
@@ -0,0 +1,149 @@
+#ifndef STATUSQUERY_H
+#define STATUSQUERY_H
+
+#include <QVector>
+#include <QString>
+#include <QDateTime>
+#include <algorithm>
+#include <limits>
+#include <ranges>
+#include "StatusData.h"
+
+/**
+ * @brief 状态筛选条件，未设置的条件不参与筛选
+ */
+struct StatusFilter {
+    QDateTime from;      // 与时间段 [from, to) 相交
+    QDateTime to;
+    QDateTime activeAt;  // 在该时刻有效
+    QDateTime expiredAt; // 在该时刻已过期
+    QString icon;        // 图标完全相同
+    QString text;        // 描述包含该文本（不区分大小写）
+
+    bool operator()(const StatusData &status) const {
+        if (activeAt.isValid() && !status.isActiveAt(activeAt)) return false;
+        if (expiredAt.isValid() && !status.isExpiredAt(expiredAt)) return false;
+        if (from.isValid() && status.endDateTime() <= from) return false;
+        if (to.isValid() && status.startDateTime >= to) return false;
+        if (!icon.isEmpty() && status.icon != icon) return false;
+        if (!text.isEmpty() && !status.description.contains(text, Qt::CaseInsensitive)) return false;
+        return true;
+    }
+};
+
+/**
+ * @brief 状态查询，组合筛选条件后返回惰性视图
+ *
+ * 视图直接在 StatusManager 的存储（按起始时间排序）上求值，不复制数据、
+ * 不分配内存；利用排序先用二分查找截掉不可能匹配的尾部。
+ * 视图引用底层存储，状态数据变化后需要重新查询。
+ *
+ * 用法：
+ *     for (const StatusData &status : manager->query().activeAt(now).limit(3).view()) { ... }
+ */
+class StatusQuery {
+public:
+    explicit StatusQuery(const QVector<StatusData> &storage)
+        : m_storage(&storage)
+          , m_offset(0)
+          , m_limit(std::numeric_limits<qsizetype>::max())
+          , m_order(Qt::AscendingOrder) {
+    }
+
+    StatusQuery &overlapping(const QDateTime &from, const QDateTime &to) {
+        m_filter.from = from;
+        m_filter.to = to;
+        return *this;
+    }
+
+    StatusQuery &activeAt(const QDateTime &time) {
+        m_filter.activeAt = time;
+        return *this;
+    }
+
+    StatusQuery &expiredAt(const QDateTime &time) {
+        m_filter.expiredAt = time;
+        return *this;
+    }
+
+    StatusQuery &withIcon(const QString &icon) {
+        m_filter.icon = icon;
+        return *this;
+    }
+
+    StatusQuery &containing(const QString &text) {
+        m_filter.text = text;
+        return *this;
+    }
+
+    StatusQuery &offset(qsizetype count) {
+        m_offset = qMax<qsizetype>(0, count);
+        return *this;
+    }
+
+    StatusQuery &limit(qsizetype count) {
+        m_limit = qMax<qsizetype>(0, count);
+        return *this;
+    }
+
+    /**
+     * @brief 按起始时间升序或降序
+     */
+    StatusQuery &order(Qt::SortOrder order) {
+        m_order = order;
+        return *this;
+    }
+
+    /**
+     * @brief 生成惰性视图，元素类型为 const StatusData &
+     */
+    auto view() const {
+        const QVector<StatusData> *storage = m_storage;
+        const qsizetype count = candidateCount();
+        const bool descending = m_order == Qt::DescendingOrder;
+
+        return std::views::iota(qsizetype(0), count)
+               | std::views::transform([storage, count, descending](qsizetype i) -> const StatusData & {
+                   return (*storage)[descending ? count - 1 - i : i];
+               })
+               | std::views::filter(m_filter)
+               | std::views::drop(m_offset)
+               | std::views::take(m_limit);
+    }
+
+private:
+    /**
+     * @brief 起始时间不晚于查询上界的状态个数（存储按起始时间排序）
+     */
+    qsizetype candidateCount() const {
+        QDateTime bound;
+        bool inclusive = false;
+        if (m_filter.to.isValid()) {
+            bound = m_filter.to;
+        }
+        for (const QDateTime &time : {m_filter.activeAt, m_filter.expiredAt}) {
+            if (time.isValid() && (!bound.isValid() || time < bound)) {
+                bound = time;
+                inclusive = true;
+            }
+        }
+        if (!bound.isValid()) {
+            return m_storage->size();
+        }
+
+        auto end = std::partition_point(m_storage->cbegin(), m_storage->cend(),
+                                        [&bound, inclusive](const StatusData &status) {
+                                            return inclusive ? status.startDateTime <= bound
+                                                             : status.startDateTime < bound;
+                                        });
+        return end - m_storage->cbegin();
+    }
+
+    const QVector<StatusData> *m_storage;
+    StatusFilter m_filter;
+    qsizetype m_offset;
+    qsizetype m_limit;
+    Qt::SortOrder m_order;
+};
+
+#endif // STATUSQUERY_H
@@ -0,0 +1,153 @@
+#include "SyncSelfTest.h"
+#include "StatusManager.h"
+#include "SyncService.h"
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <cstdio>
+
+namespace {
+    const QString kToken = QStringLiteral("selftest");
+    const QString kHost = QStringLiteral("127.0.0.1");
+
+    bool loadEmpty(StatusManager &manager, const QString &path) {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        file.write("{\n  \"statuses\": []\n}");
+        file.close();
+        if (!manager.loadFromFile(path)) {
+            return false;
+        }
+        manager.setNodeId(QUuid::createUuid());
+        return true;
+    }
+
+    int indexOf(const StatusManager &manager, const QUuid &uid) {
+        const QVector<StatusData> statuses = manager.getAllStatuses();
+        for (int i = 0; i < statuses.size(); ++i) {
+            if (statuses[i].uid == uid) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    StatusData makeStatus(const QString &description, int hoursFromNow) {
+        StatusData status;
+        status.icon = "🔁";
+        status.description = description;
+        status.startDateTime = QDateTime::currentDateTime().addSecs(hoursFromNow * 3600);
+        status.durationHours = 1;
+        return status;
+    }
+}
+
+SyncSelfTest::SyncSelfTest(QObject *parent)
+    : QObject(parent) {
+}
+
+void SyncSelfTest::check(const QString &name, bool ok, const QString &detail) {
+    std::printf("sync-selftest step=%s %s%s%s\n", qPrintable(name), ok ? "ok" : "failed",
+                detail.isEmpty() ? "" : " ", qPrintable(detail));
+    std::fflush(stdout);
+    if (!ok) {
+        m_failures << name;
+    }
+}
+
+bool SyncSelfTest::syncOnce(SyncService *client, quint16 port, int &sent, int &applied) {
+    bool finished = false;
+    sent = -1;
+    applied = -1;
+
+    QEventLoop loop;
+    connect(client, &SyncService::syncFinished, &loop, [&](const QString &, int sentCount, int appliedCount) {
+        finished = true;
+        sent = sentCount;
+        applied = appliedCount;
+        loop.quit();
+    });
+    connect(client, &SyncService::syncFailed, &loop, &QEventLoop::quit);
+    QTimer::singleShot(SYNC_TIMEOUT, &loop, &QEventLoop::quit);
+
+    client->syncWith(kHost, port);
+    loop.exec();
+    return finished;
+}
+
+int SyncSelfTest::run() {
+    // 两份独立的数据，不影响用户的 status.json
+    QTemporaryDir dataDir;
+    StatusManager server;
+    StatusManager client;
+    if (!dataDir.isValid() || !loadEmpty(server, dataDir.filePath("server.json"))
+        || !loadEmpty(client, dataDir.filePath("client.json"))) {
+        check("setup", false, "无法创建临时数据");
+        return 1;
+    }
+
+    {
+        SyncService open(&server);
+        check("refuse-open", !open.listen(QHostAddress::Any, 0) && open.listen(QHostAddress::LocalHost, 0));
+    }
+
+    SyncService serverSync(&server);
+    serverSync.setToken(kToken);
+    if (!serverSync.listen(QHostAddress::LocalHost, 0)) {
+        check("setup", false, "无法监听回环地址");
+        return 1;
+    }
+    const quint16 port = serverSync.serverPort();
+    SyncService::forgetPeer(kHost, port);
+
+    SyncService clientSync(&client);
+    clientSync.setToken(kToken);
+    int sent = 0;
+    int applied = 0;
+
+    client.addStatus(makeStatus("自检：客户端新增", 1));
+    const QUuid pushed = client.getAllStatuses().first().uid;
+    bool ok = syncOnce(&clientSync, port, sent, applied);
+    check("push", ok && indexOf(server, pushed) >= 0, QString("sent=%1 applied=%2").arg(sent).arg(applied));
+
+    server.addStatus(makeStatus("自检：服务端新增", 2));
+    const QUuid added = server.getAllStatuses().last().uid;
+    if (indexOf(server, pushed) >= 0) {
+        server.removeStatus(indexOf(server, pushed));
+    }
+    ok = syncOnce(&clientSync, port, sent, applied);
+    check("pull", ok && indexOf(client, added) >= 0 && indexOf(client, pushed) < 0,
+          QString("sent=%1 applied=%2").arg(sent).arg(applied));
+
+    ok = syncOnce(&clientSync, port, sent, applied);
+    check("incremental", ok && sent == 0 && applied == 0, QString("sent=%1 applied=%2").arg(sent).arg(applied));
+
+    {
+        // 模拟客户端重启：同一文件、同一节点标识，双方各有一条新变更
+        StatusManager restarted;
+        const bool reloaded = restarted.loadFromFile(dataDir.filePath("client.json"));
+        restarted.setNodeId(client.nodeId());
+        SyncService restartedSync(&restarted);
+        restartedSync.setToken(kToken);
+        restarted.addStatus(makeStatus("自检：重启后新增", 3));
+        server.addStatus(makeStatus("自检：服务端再次新增", 4));
+        ok = reloaded && syncOnce(&restartedSync, port, sent, applied);
+        check("restart", ok && restarted.journalEpoch() == client.journalEpoch() && sent == 1 && applied == 1,
+              QString("sent=%1 applied=%2").arg(sent).arg(applied));
+    }
+
+    {
+        SyncService wrong(&client);
+        wrong.setToken("wrong-" + kToken);
+        check("bad-token", !syncOnce(&wrong, port, sent, applied));
+    }
+
+    SyncService::forgetPeer(kHost, port);
+
+    std::printf("sync-selftest result=%s\n", m_failures.isEmpty() ? "pass" : "fail");
+    std::fflush(stdout);
+    return m_failures.isEmpty() ? 0 : 1;
+}
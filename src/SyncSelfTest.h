@@ -0,0 +1,48 @@
+#ifndef SYNCSELFTEST_H
+#define SYNCSELFTEST_H
+
+#include <QObject>
+#include <QStringList>
+
+class SyncService;
+
+/**
+ * @brief 同步服务的端到端自检（--sync-selftest）
+ *
+ * 在临时目录中用两份独立的数据各运行一个同步服务，经本机回环地址实际收发，依次检查：
+ *     refuse-open     没有口令时拒绝在非回环地址监听
+ *     push            客户端新增的状态同步到服务端
+ *     pull            服务端的新增和删除同步回客户端
+ *     incremental     没有新变更时不重复发送
+ *     restart         客户端从同一文件重新加载后，双方只传输重启后的变更
+ *     bad-token       口令不一致时请求被拒绝
+ * 每项输出一行结果，最后输出 sync-selftest result=pass 或 fail，失败时以1退出。
+ * 结束时删除设置中为这些临时连接保存的同步进度。
+ */
+class SyncSelfTest : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SyncSelfTest(QObject *parent = nullptr);
+
+    /**
+     * @brief 运行全部检查
+     * @return 退出码，有检查失败时为1
+     */
+    int run();
+
+private:
+    /**
+     * @brief 发起一次同步并等待完成或失败
+     * @return 是否成功；sent、applied 为同步结果
+     */
+    bool syncOnce(SyncService *client, quint16 port, int &sent, int &applied);
+
+    void check(const QString &name, bool ok, const QString &detail = QString());
+
+    QStringList m_failures;
+
+    static const int SYNC_TIMEOUT = 20000;
+};
+
+#endif // SYNCSELFTEST_H
@@ -0,0 +1,404 @@
+#include "SyncService.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QSettings>
+#include <QtEndian>
+#include <limits>
+
+namespace {
+    // 帧：4字节长度（大端）+ 1字节标志 + 负载；负载为QDataStream编码
+    const quint32 kMagic = 0x53545359; // "STSY"
+    const quint16 kProtocolVersion = 2;
+    const quint8 kFlagCompressed = 0x01;
+    const int kFrameHeaderBytes = 5;
+    const quint32 kMaxFrameBytes = 64 * 1024 * 1024;
+    const int kCompressThreshold = 512;
+    const qint64 kInvalidSecs = std::numeric_limits<qint64>::min();
+
+    enum MessageType : quint8 {
+        Request = 1,
+        Response = 2
+    };
+
+    enum ResponseStatus : quint8 {
+        Ok = 0,
+        Unauthorized = 1,
+        BadRequest = 2
+    };
+
+    /**
+     * @brief 一批变更及其所属纪元和修订号
+     */
+    struct Delta {
+        QUuid epoch;
+        quint64 revision = 0;
+        bool full = false;
+        QVector<StatusChange> changes;
+    };
+
+    void writeDelta(QDataStream &stream, const Delta &delta) {
+        stream << delta.epoch << delta.revision << delta.full << quint32(delta.changes.size());
+        for (const StatusChange &change : delta.changes) {
+            const StatusData &status = change.status;
+            qint64 startSecs = status.startDateTime.isValid() ? status.startDateTime.toSecsSinceEpoch() : kInvalidSecs;
+            stream << status.uid << status.modifiedAt << change.origin << change.deleted
+                    << startSecs << qint32(status.durationHours) << qint32(status.priority)
+                    << status.icon.toUtf8() << status.description.toUtf8();
+        }
+    }
+
+    bool readDelta(QDataStream &stream, Delta &delta) {
+        quint32 count = 0;
+        stream >> delta.epoch >> delta.revision >> delta.full >> count;
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        // 数量来自网络，不据此预分配
+        for (quint32 i = 0; i < count; ++i) {
+            StatusChange change;
+            StatusData &status = change.status;
+            qint64 startSecs = 0;
+            qint32 duration = 0;
+            qint32 priority = 0;
+            QByteArray icon;
+            QByteArray description;
+            stream >> status.uid >> status.modifiedAt >> change.origin >> change.deleted
+                    >> startSecs >> duration >> priority >> icon >> description;
+            if (stream.status() != QDataStream::Ok) {
+                return false;
+            }
+            status.startDateTime = startSecs == kInvalidSecs ? QDateTime() : QDateTime::fromSecsSinceEpoch(startSecs);
+            status.durationHours = duration;
+            status.priority = priority;
+            status.icon = QString::fromUtf8(icon);
+            status.description = QString::fromUtf8(description);
+            delta.changes.append(change);
+        }
+        return true;
+    }
+
+    void writeFrame(QTcpSocket *socket, const QByteArray &payload) {
+        quint8 flags = 0;
+        QByteArray body = payload;
+        if (payload.size() > kCompressThreshold) {
+            body = qCompress(payload);
+            flags |= kFlagCompressed;
+        }
+
+        char header[kFrameHeaderBytes];
+        qToBigEndian<quint32>(quint32(body.size()), header);
+        header[4] = char(flags);
+        socket->write(header, kFrameHeaderBytes);
+        socket->write(body);
+    }
+
+    /**
+     * @brief 从套接字缓冲区取出一个完整帧
+     * @return 取到帧返回true；数据不足返回false且 error 为false
+     */
+    bool takeFrame(QTcpSocket *socket, QByteArray &payload, bool &error) {
+        error = false;
+        if (socket->bytesAvailable() < kFrameHeaderBytes) {
+            return false;
+        }
+
+        QByteArray header = socket->peek(kFrameHeaderBytes);
+        quint32 length = qFromBigEndian<quint32>(header.constData());
+        if (length > kMaxFrameBytes) {
+            error = true;
+            return false;
+        }
+        if (socket->bytesAvailable() < kFrameHeaderBytes + qint64(length)) {
+            return false;
+        }
+
+        socket->skip(kFrameHeaderBytes);
+        payload = socket->read(length);
+        if (quint8(header[4]) & kFlagCompressed) {
+            payload = qUncompress(payload);
+            if (payload.isEmpty()) {
+                error = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 对端在设置中的分组名（"host:port" 中的冒号不适合作为键）
+     */
+    QString peerGroup(const QString &peer) {
+        QString key = peer;
+        key.replace(':', '_');
+        key.replace('/', '_');
+        return "sync/state/" + key;
+    }
+}
+
+SyncService::SyncService(StatusManager *manager, QObject *parent)
+    : QObject(parent)
+      , m_statusManager(manager) {
+    m_server = new QTcpServer(this);
+    connect(m_server, &QTcpServer::newConnection, this, &SyncService::onNewConnection);
+
+    m_periodicTimer = new QTimer(this);
+    connect(m_periodicTimer, &QTimer::timeout, this, &SyncService::syncAll);
+
+    m_debounceTimer = new QTimer(this);
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(DEBOUNCE_INTERVAL);
+    connect(m_debounceTimer, &QTimer::timeout, this, &SyncService::syncAll);
+
+    connect(m_statusManager, &StatusManager::statusesChanged, this, [this]() {
+        if (!m_peers.isEmpty()) {
+            m_debounceTimer->start();
+        }
+    });
+}
+
+void SyncService::startFromSettings() {
+    QSettings settings("StatusApp", "StatusDisplayApp");
+
+    // 节点标识需要跨重启保持，对端据此过滤回传的变更
+    QUuid nodeId = QUuid::fromString(settings.value("sync/nodeId").toString());
+    if (nodeId.isNull()) {
+        nodeId = QUuid::createUuid();
+        settings.setValue("sync/nodeId", nodeId.toString(QUuid::WithoutBraces));
+    }
+    m_statusManager->setNodeId(nodeId);
+
+    m_token = settings.value("sync/token").toString();
+    m_peers = settings.value("sync/peers").toStringList();
+
+    quint16 port = static_cast<quint16>(settings.value("sync/listenPort", 0).toUInt());
+    if (port != 0) {
+        // 没有口令时默认只接受本机连接
+        QHostAddress address(settings.value("sync/listenAddress").toString());
+        if (address.isNull()) {
+            address = m_token.isEmpty() ? QHostAddress(QHostAddress::LocalHost) : QHostAddress(QHostAddress::Any);
+        }
+        listen(address, port);
+    }
+
+    int interval = settings.value("sync/intervalSeconds", 60).toInt();
+    if (!m_peers.isEmpty() && interval > 0) {
+        m_periodicTimer->start(interval * 1000);
+        syncAll();
+    }
+}
+
+bool SyncService::listen(const QHostAddress &address, quint16 port) {
+    // 任何连接到该端口的设备都能读写全部状态，没有口令时不对外监听
+    if (m_token.isEmpty() && !address.isLoopback()) {
+        qWarning() << "未设置 sync/token，拒绝在非本机地址监听:" << address.toString();
+        return false;
+    }
+    if (!m_server->listen(address, port)) {
+        qWarning() << "同步服务无法监听:" << m_server->errorString();
+        return false;
+    }
+    return true;
+}
+
+quint16 SyncService::serverPort() const {
+    return m_server->serverPort();
+}
+
+void SyncService::syncAll() {
+    for (const QString &peer : std::as_const(m_peers)) {
+        int separator = peer.lastIndexOf(':');
+        bool ok = false;
+        quint16 port = separator > 0 ? peer.mid(separator + 1).toUShort(&ok) : 0;
+        if (!ok) {
+            qWarning() << "同步对端格式错误:" << peer;
+            continue;
+        }
+        syncWith(peer.left(separator), port);
+    }
+}
+
+SyncService::PeerState SyncService::loadPeerState(const QString &peer) {
+    QSettings settings("StatusApp", "StatusDisplayApp");
+    settings.beginGroup(peerGroup(peer));
+    PeerState state;
+    state.node = QUuid::fromString(settings.value("node").toString());
+    state.serverEpoch = QUuid::fromString(settings.value("serverEpoch").toString());
+    state.serverRevision = settings.value("serverRevision", 0).toULongLong();
+    state.pushedEpoch = QUuid::fromString(settings.value("pushedEpoch").toString());
+    state.pushedRevision = settings.value("pushedRevision", 0).toULongLong();
+    return state;
+}
+
+void SyncService::forgetPeer(const QString &host, quint16 port) {
+    QSettings settings("StatusApp", "StatusDisplayApp");
+    settings.remove(peerGroup(host + ':' + QString::number(port)));
+}
+
+void SyncService::savePeerState(const QString &peer, const PeerState &state) {
+    QSettings settings("StatusApp", "StatusDisplayApp");
+    settings.beginGroup(peerGroup(peer));
+    settings.setValue("node", state.node.toString(QUuid::WithoutBraces));
+    settings.setValue("serverEpoch", state.serverEpoch.toString(QUuid::WithoutBraces));
+    settings.setValue("serverRevision", state.serverRevision);
+    settings.setValue("pushedEpoch", state.pushedEpoch.toString(QUuid::WithoutBraces));
+    settings.setValue("pushedRevision", state.pushedRevision);
+}
+
+void SyncService::syncWith(const QString &host, quint16 port) {
+    const QString peer = host + ':' + QString::number(port);
+    const PeerState state = loadPeerState(peer);
+
+    // 只发送对端没有见过的本机变更；本机纪元变化后发送完整状态
+    Delta outgoing;
+    outgoing.epoch = m_statusManager->journalEpoch();
+    outgoing.revision = m_statusManager->revision();
+    outgoing.changes = m_statusManager->changesSince(state.pushedEpoch, state.pushedRevision,
+                                                     state.node, &outgoing.full);
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kMagic << kProtocolVersion << quint8(Request) << m_statusManager->nodeId() << m_token
+            << state.serverEpoch << state.serverRevision;
+    writeDelta(stream, outgoing);
+
+    QTcpSocket *socket = new QTcpSocket(this);
+    QTimer *timeout = new QTimer(socket);
+    timeout->setSingleShot(true);
+
+    auto fail = [this, socket, peer](const QString &message) {
+        disconnect(socket, nullptr, this, nullptr);
+        socket->abort();
+        socket->deleteLater();
+        qWarning() << "同步失败:" << peer << message;
+        emit syncFailed(peer, message);
+    };
+
+    connect(socket, &QTcpSocket::connected, this, [socket, payload]() {
+        writeFrame(socket, payload);
+    });
+    connect(socket, &QTcpSocket::readyRead, this,
+            [this, socket, peer, state, outgoing, fail]() {
+                QByteArray response;
+                bool error = false;
+                if (takeFrame(socket, response, error)) {
+                    disconnect(socket, nullptr, this, nullptr);
+                    QDataStream in(response);
+                    in.setVersion(QDataStream::Qt_6_0);
+                    quint32 magic = 0;
+                    quint16 version = 0;
+                    quint8 type = 0;
+                    quint8 status = BadRequest;
+                    QUuid serverNode;
+                    Delta incoming;
+                    in >> magic >> version >> type >> status >> serverNode;
+                    if (magic != kMagic || version != kProtocolVersion || type != Response) {
+                        fail("响应格式错误");
+                        return;
+                    }
+                    if (status != Ok) {
+                        fail(status == Unauthorized ? "口令不匹配" : "对端拒绝请求");
+                        return;
+                    }
+                    if (!readDelta(in, incoming)) {
+                        fail("响应数据损坏");
+                        return;
+                    }
+
+                    int applied = m_statusManager->applyChanges(incoming.changes, serverNode);
+
+                    PeerState updated = state;
+                    updated.node = serverNode;
+                    updated.serverEpoch = incoming.epoch;
+                    updated.serverRevision = incoming.revision;
+                    updated.pushedEpoch = outgoing.epoch;
+                    updated.pushedRevision = outgoing.revision;
+                    savePeerState(peer, updated);
+
+                    socket->disconnectFromHost();
+                    socket->deleteLater();
+                    emit syncFinished(peer, int(outgoing.changes.size()), applied);
+                } else if (error) {
+                    fail("响应帧错误");
+                }
+            });
+    connect(socket, &QTcpSocket::errorOccurred, this, [socket, fail]() {
+        fail(socket->errorString());
+    });
+    connect(timeout, &QTimer::timeout, this, [fail]() {
+        fail("超时");
+    });
+
+    timeout->start(REQUEST_TIMEOUT);
+    socket->connectToHost(host, port);
+}
+
+void SyncService::onNewConnection() {
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            handleRequest(socket);
+        });
+        QTimer::singleShot(REQUEST_TIMEOUT, socket, [socket]() {
+            socket->abort();
+            socket->deleteLater();
+        });
+    }
+}
+
+void SyncService::handleRequest(QTcpSocket *socket) {
+    QByteArray request;
+    bool error = false;
+    if (!takeFrame(socket, request, error)) {
+        if (error) {
+            socket->abort();
+            socket->deleteLater();
+        }
+        return;
+    }
+    disconnect(socket, &QTcpSocket::readyRead, this, nullptr);
+
+    QDataStream in(request);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint8 type = 0;
+    QUuid clientNode;
+    QString token;
+    QUuid knownEpoch;
+    quint64 knownRevision = 0;
+    Delta incoming;
+    in >> magic >> version >> type >> clientNode >> token >> knownEpoch >> knownRevision;
+
+    quint8 status = Ok;
+    if (magic != kMagic || version != kProtocolVersion || type != Request) {
+        status = BadRequest;
+    } else if (!m_token.isEmpty() && token != m_token) {
+        status = Unauthorized;
+    } else if (!readDelta(in, incoming)) {
+        status = BadRequest;
+    }
+
+    Delta outgoing;
+    if (status == Ok) {
+        // 先应用客户端的变更，再回复客户端尚未见过的变更（不回传刚收到的）
+        m_statusManager->applyChanges(incoming.changes, clientNode);
+        outgoing.epoch = m_statusManager->journalEpoch();
+        outgoing.revision = m_statusManager->revision();
+        outgoing.changes = m_statusManager->changesSince(knownEpoch, knownRevision, clientNode, &outgoing.full);
+    } else {
+        qWarning() << "拒绝同步请求:" << socket->peerAddress().toString();
+    }
+
+    QByteArray response;
+    QDataStream out(&response, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kMagic << kProtocolVersion << quint8(Response) << status << m_statusManager->nodeId();
+    if (status == Ok) {
+        writeDelta(out, outgoing);
+    }
+
+    writeFrame(socket, response);
+    socket->disconnectFromHost();
+}
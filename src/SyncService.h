@@ -0,0 +1,111 @@
+#ifndef SYNCSERVICE_H
+#define SYNCSERVICE_H
+
+#include <QObject>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUuid>
+#include "StatusManager.h"
+
+/**
+ * @brief 多设备增量同步服务
+ *
+ * 每台设备既可以监听（供其他设备连接），也可以定期连接配置的对端。
+ * 一次同步为一问一答：客户端发送自上次同步以来本机主数据源的变更，
+ * 服务端应用后回复客户端尚未见过的变更。变更以二进制帧传输，较大时压缩。
+ * 冲突按修改时间后写入者优先，时间相同时按内容确定胜者，各设备结果一致。
+ *
+ * 设置项（QSettings "StatusApp"/"StatusDisplayApp"）：
+ *     sync/enabled          是否启用
+ *     sync/listenAddress    监听地址，默认任意地址；未设置口令时默认本机回环地址
+ *     sync/listenPort       监听端口，0 表示不监听
+ *     sync/peers            对端列表，形如 "192.168.1.20:45454"
+ *     sync/intervalSeconds  定期同步间隔，默认60秒
+ *     sync/token            共享口令，两端需一致；未设置时只能在回环地址监听
+ */
+class SyncService : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SyncService(StatusManager *manager, QObject *parent = nullptr);
+
+    /**
+     * @brief 按设置启动监听和定期同步
+     */
+    void startFromSettings();
+
+    /**
+     * @brief 开始监听，端口为0时由系统分配（见 serverPort()）
+     *
+     * 没有设置口令时只允许回环地址，否则返回false。
+     */
+    bool listen(const QHostAddress &address, quint16 port);
+
+    quint16 serverPort() const;
+
+    /**
+     * @brief 设置共享口令，空表示不校验（此时只能在回环地址监听）
+     */
+    void setToken(const QString &token) { m_token = token; }
+
+    /**
+     * @brief 与指定对端同步一次
+     */
+    void syncWith(const QString &host, quint16 port);
+
+    /**
+     * @brief 与所有配置的对端同步
+     */
+    void syncAll();
+
+    /**
+     * @brief 删除设置中保存的与该对端的同步进度
+     */
+    static void forgetPeer(const QString &host, quint16 port);
+
+signals:
+    /**
+     * @brief 同步完成
+     * @param peer 对端（host:port）
+     * @param sent 发送的变更数
+     * @param applied 本机实际应用的变更数
+     */
+    void syncFinished(const QString &peer, int sent, int applied);
+
+    void syncFailed(const QString &peer, const QString &message);
+
+private slots:
+    void onNewConnection();
+
+private:
+    /**
+     * @brief 一个对端的同步进度，保存在设置中
+     */
+    struct PeerState {
+        QUuid node;          // 对端节点标识
+        QUuid serverEpoch;   // 已收到的对端变更所属纪元
+        quint64 serverRevision = 0;
+        QUuid pushedEpoch;   // 已推送的本机变更所属纪元
+        quint64 pushedRevision = 0;
+    };
+
+    static PeerState loadPeerState(const QString &peer);
+
+    static void savePeerState(const QString &peer, const PeerState &state);
+
+    void handleRequest(QTcpSocket *socket);
+
+    StatusManager *m_statusManager;
+    QTcpServer *m_server;
+    QTimer *m_periodicTimer;
+    QTimer *m_debounceTimer;
+    QString m_token;
+    QStringList m_peers;
+
+    static const int DEBOUNCE_INTERVAL = 2000;  // 本地修改后延迟同步，合并连续修改
+    static const int REQUEST_TIMEOUT = 15000;
+};
+
+#endif // SYNCSERVICE_H
@@ -0,0 +1,465 @@
+#include "TimelineWidget.h"
+#include "IsoTimestamp.h"
+#include <QPainter>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QtMath>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+
+namespace {
+    constexpr qint64 kMinBucketSecs = 300;      // 最细汇总桶：5分钟
+    constexpr qint64 kMaxBaseBuckets = 1 << 22; // 最细级别的桶数上限
+    constexpr double kMinSecsPerPixel = 1.0;
+    constexpr qint64 kMinViewSecs = 10 * 365 * 86400; // 缩小时至少能看到的跨度：10年
+
+    // 时间轴刻度间隔候选（秒）
+    constexpr qint64 kTickSteps[] = {
+        60, 300, 900, 1800, 3600, 3 * 3600, 6 * 3600, 12 * 3600,
+        86400, 7 * 86400, 30 * 86400, 365 * 86400
+    };
+    constexpr int kMinTickSpacing = 90; // 刻度最小像素间距
+
+    qint64 floorDiv(qint64 value, qint64 divisor) {
+        qint64 quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+
+    QColor colorFor(const QString &icon) {
+        return QColor::fromHsv(static_cast<int>(qHash(icon) % 360), 110, 235);
+    }
+}
+
+TimelineWidget::TimelineWidget(StatusManager *manager, QWidget *parent)
+    : QWidget(parent)
+      , m_statusManager(manager)
+      , m_dirty(true)
+      , m_endTreeLeaves(0)
+      , m_laneCount(0)
+      , m_origin(0)
+      , m_bucketSecs(kMinBucketSecs)
+      , m_peak(0)
+      , m_viewStart(0)
+      , m_secsPerPixel(0)
+      , m_laneOffset(0)
+      , m_panning(false)
+      , m_panStartTime(0)
+      , m_panStartLane(0) {
+    setMouseTracking(true);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    connect(m_statusManager, &StatusManager::statusesChanged,
+            this, &TimelineWidget::onStatusesChanged);
+}
+
+QSize TimelineWidget::sizeHint() const {
+    return QSize(760, 480);
+}
+
+void TimelineWidget::onStatusesChanged() {
+    m_dirty = true;
+    if (isVisible()) {
+        rebuild();
+        update();
+    }
+}
+
+void TimelineWidget::showEvent(QShowEvent *event) {
+    if (m_dirty) {
+        rebuild();
+    }
+    if (m_secsPerPixel <= 0) {
+        fitAll();
+    }
+    QWidget::showEvent(event);
+}
+
+void TimelineWidget::rebuild() {
+    m_dirty = false;
+
+    // 合并视图已按起始时间排序，直接遍历查询视图，只保留时间有效的状态
+    m_statuses.clear();
+    m_starts.clear();
+    m_ends.clear();
+
+    for (const StatusData &status : m_statusManager->query().view()) {
+        if (!status.startDateTime.isValid()) {
+            continue;
+        }
+        qint64 start = status.startDateTime.toSecsSinceEpoch();
+        qint64 end = start + qMax(0, status.durationHours) * qint64(3600);
+        m_statuses.append(&status);
+        m_starts.append(start);
+        m_ends.append(end);
+    }
+
+    buildLanes();
+    buildLevels();
+    buildEndTree();
+}
+
+void TimelineWidget::buildEndTree() {
+    m_endTreeLeaves = 1;
+    while (m_endTreeLeaves < m_ends.size()) {
+        m_endTreeLeaves *= 2;
+    }
+    m_endTree.fill(std::numeric_limits<qint64>::min(), 2 * m_endTreeLeaves);
+    std::copy(m_ends.constBegin(), m_ends.constEnd(), m_endTree.begin() + m_endTreeLeaves);
+    for (int node = m_endTreeLeaves - 1; node > 0; --node) {
+        m_endTree[node] = qMax(m_endTree[2 * node], m_endTree[2 * node + 1]);
+    }
+}
+
+void TimelineWidget::buildLanes() {
+    // 贪心区间划分：每个状态放入最早空闲的行
+    using LaneEnd = std::pair<qint64, int>;
+    std::priority_queue<LaneEnd, std::vector<LaneEnd>, std::greater<LaneEnd>> freeAt;
+
+    m_lanes.resize(m_starts.size());
+    m_laneCount = 0;
+    for (int i = 0; i < m_starts.size(); ++i) {
+        int lane;
+        if (!freeAt.empty() && freeAt.top().first <= m_starts[i]) {
+            lane = freeAt.top().second;
+            freeAt.pop();
+        } else {
+            lane = m_laneCount++;
+        }
+        m_lanes[i] = lane;
+        freeAt.push({qMax(m_ends[i], m_starts[i] + 1), lane});
+    }
+    m_laneOffset = qBound(0, m_laneOffset, qMax(0, m_laneCount - 1));
+}
+
+void TimelineWidget::buildLevels() {
+    m_levels.clear();
+    m_peak = 0;
+    if (m_starts.isEmpty()) {
+        return;
+    }
+
+    qint64 last = *std::max_element(m_ends.constBegin(), m_ends.constEnd());
+    m_origin = floorDiv(m_starts.first(), 3600) * 3600;
+    qint64 span = qMax<qint64>(last - m_origin, 1);
+    m_bucketSecs = qMax(kMinBucketSecs, (span + kMaxBaseBuckets - 1) / kMaxBaseBuckets);
+    qsizetype bucketCount = span / m_bucketSecs + 1;
+
+    // 差分数组求出每个桶内的并发数
+    QVector<int> base(bucketCount + 1, 0);
+    for (int i = 0; i < m_starts.size(); ++i) {
+        qint64 first = (m_starts[i] - m_origin) / m_bucketSecs;
+        qint64 lastBucket = (qMax(m_ends[i] - 1, m_starts[i]) - m_origin) / m_bucketSecs;
+        base[first] += 1;
+        base[lastBucket + 1] -= 1;
+    }
+    int running = 0;
+    for (qsizetype b = 0; b < bucketCount; ++b) {
+        running += base[b];
+        base[b] = running;
+        m_peak = qMax(m_peak, running);
+    }
+    base.resize(bucketCount);
+    m_levels.append(base);
+
+    // 逐级合并，每级取子桶最大值
+    while (m_levels.last().size() > 1) {
+        const QVector<int> &finer = m_levels.last();
+        QVector<int> coarser((finer.size() + LEVEL_FANOUT - 1) / LEVEL_FANOUT, 0);
+        for (qsizetype b = 0; b < finer.size(); ++b) {
+            int &slot = coarser[b / LEVEL_FANOUT];
+            slot = qMax(slot, finer[b]);
+        }
+        m_levels.append(coarser);
+    }
+}
+
+void TimelineWidget::fitAll() {
+    int w = qMax(width(), 1);
+    if (m_starts.isEmpty()) {
+        qint64 now = QDateTime::currentSecsSinceEpoch();
+        m_secsPerPixel = 86400.0 / w;
+        m_viewStart = now - 43200;
+    } else {
+        qint64 first = m_starts.first();
+        qint64 last = *std::max_element(m_ends.constBegin(), m_ends.constEnd());
+        qint64 margin = qMax<qint64>((last - first) / 20, 3600);
+        m_secsPerPixel = qMax(kMinSecsPerPixel, double(last - first + 2 * margin) / w);
+        m_viewStart = first - margin;
+    }
+    m_laneOffset = 0;
+    update();
+}
+
+int TimelineWidget::levelFor(double secsPerPixel) const {
+    int level = 0;
+    double bucketWidth = double(m_bucketSecs);
+    while (bucketWidth < secsPerPixel && level + 1 < m_levels.size()) {
+        bucketWidth *= LEVEL_FANOUT;
+        ++level;
+    }
+    return level;
+}
+
+bool TimelineWidget::visibleBars(qint64 from, qint64 to, int limit, QVector<int> &indices) const {
+    indices.clear();
+    // 起始时间早于 to 的状态是一段前缀，其中结束时间晚于 from 的才相交；
+    // 只进入子树最大结束时间晚于 from 的节点，耗时与结果数量成正比，不受个别很长的状态影响
+    const int last = static_cast<int>(std::lower_bound(m_starts.constBegin(), m_starts.constEnd(), to)
+                                      - m_starts.constBegin());
+    if (last == 0) {
+        return true;
+    }
+
+    struct Node {
+        int index;
+        int lo;
+        int hi;
+    };
+    QVarLengthArray<Node, 64> stack;
+    stack.append({1, 0, m_endTreeLeaves});
+    while (!stack.isEmpty()) {
+        const Node node = stack.takeLast();
+        if (node.lo >= last || m_endTree[node.index] <= from) {
+            continue;
+        }
+        if (node.hi - node.lo == 1) {
+            indices.append(node.lo);
+            if (indices.size() > limit) {
+                return false;
+            }
+            continue;
+        }
+        const int mid = (node.lo + node.hi) / 2;
+        stack.append({2 * node.index + 1, mid, node.hi}); // 先处理左子树，保持升序
+        stack.append({2 * node.index, node.lo, mid});
+    }
+    return true;
+}
+
+double TimelineWidget::maxSecsPerPixel() const {
+    qint64 span = kMinViewSecs;
+    if (!m_starts.isEmpty()) {
+        qint64 last = *std::max_element(m_ends.constBegin(), m_ends.constEnd());
+        span = qMax(span, (last - m_starts.first()) * 2);
+    }
+    return qMax(kMinSecsPerPixel, double(span) / qMax(width(), 1));
+}
+
+qint64 TimelineWidget::timeAt(double x) const {
+    return m_viewStart + static_cast<qint64>(x * m_secsPerPixel);
+}
+
+double TimelineWidget::xAt(qint64 secs) const {
+    return double(secs - m_viewStart) / m_secsPerPixel;
+}
+
+void TimelineWidget::paintEvent(QPaintEvent *) {
+    if (m_dirty) {
+        rebuild();
+    }
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    qint64 viewEnd = timeAt(width());
+    QVector<int> visible;
+    if (visibleBars(m_viewStart, viewEnd, MAX_VISIBLE_BARS, visible)) {
+        paintBars(painter, visible);
+    } else {
+        paintDensity(painter, viewEnd);
+    }
+
+    // 当前时间线
+    double nowX = xAt(QDateTime::currentSecsSinceEpoch());
+    if (nowX >= 0 && nowX <= width()) {
+        painter.setPen(QPen(QColor(230, 60, 60), 1));
+        painter.drawLine(QPointF(nowX, AXIS_HEIGHT), QPointF(nowX, height()));
+    }
+
+    paintAxis(painter, viewEnd);
+}
+
+void TimelineWidget::paintAxis(QPainter &painter, qint64 viewEnd) {
+    painter.fillRect(0, 0, width(), AXIS_HEIGHT, QColor(245, 245, 245));
+    painter.setPen(QColor(200, 200, 200));
+    painter.drawLine(0, AXIS_HEIGHT - 1, width(), AXIS_HEIGHT - 1);
+
+    qint64 step = kTickSteps[std::size(kTickSteps) - 1];
+    for (qint64 candidate : kTickSteps) {
+        if (candidate / m_secsPerPixel >= kMinTickSpacing) {
+            step = candidate;
+            break;
+        }
+    }
+
+    // 刻度按本地时间对齐
+    int offset = QDateTime::currentDateTime().offsetFromUtc();
+    qint64 tick = floorDiv(m_viewStart + offset, step) * step - offset;
+    for (; tick <= viewEnd; tick += step) {
+        double x = xAt(tick);
+        painter.setPen(QColor(200, 200, 200));
+        painter.drawLine(QPointF(x, AXIS_HEIGHT - 6), QPointF(x, AXIS_HEIGHT - 1));
+
+        QDateTime time = QDateTime::fromSecsSinceEpoch(tick);
+        QString label = step >= 86400
+                            ? IsoTimestamp::formatDisplay(time, IsoTimestamp::DateTimeMinutes).left(10)
+                            : IsoTimestamp::formatDisplay(time, IsoTimestamp::MonthDayMinutes);
+        painter.setPen(QColor(102, 102, 102));
+        painter.drawText(QPointF(x + 3, AXIS_HEIGHT - 8), label);
+    }
+}
+
+void TimelineWidget::paintDensity(QPainter &painter, qint64 viewEnd) {
+    if (m_levels.isEmpty() || m_peak <= 0) {
+        return;
+    }
+
+    int level = levelFor(m_secsPerPixel);
+    const QVector<int> &buckets = m_levels[level];
+    qint64 bucketWidth = m_bucketSecs;
+    for (int i = 0; i < level; ++i) {
+        bucketWidth *= LEVEL_FANOUT;
+    }
+
+    qint64 firstBucket = qMax<qint64>(0, floorDiv(m_viewStart - m_origin, bucketWidth));
+    qint64 lastBucket = qMin<qint64>(buckets.size() - 1, floorDiv(viewEnd - m_origin, bucketWidth));
+
+    int bandTop = AXIS_HEIGHT + 4;
+    int bandHeight = height() - bandTop - 4;
+    QColor bandColor(76, 175, 80);
+
+    for (qint64 b = firstBucket; b <= lastBucket; ++b) {
+        int count = buckets[b];
+        if (count == 0) {
+            continue;
+        }
+        double x0 = xAt(m_origin + b * bucketWidth);
+        double x1 = xAt(m_origin + (b + 1) * bucketWidth);
+        double h = bandHeight * double(count) / m_peak;
+        bandColor.setAlpha(80 + 175 * count / m_peak);
+        painter.fillRect(QRectF(x0, bandTop + bandHeight - h, qMax(x1 - x0, 1.0), h), bandColor);
+    }
+
+    painter.setPen(QColor(102, 102, 102));
+    painter.drawText(QPointF(8, AXIS_HEIGHT + 16),
+                     QString("密度视图（峰值 %1 个同时有效的状态，放大查看详情）").arg(m_peak));
+}
+
+void TimelineWidget::paintBars(QPainter &painter, const QVector<int> &indices) {
+    QFontMetrics metrics(font());
+    int visibleLanes = (height() - AXIS_HEIGHT) / LANE_HEIGHT + 1;
+
+    for (int i : indices) {
+        int row = m_lanes[i] - m_laneOffset;
+        if (row < 0 || row >= visibleLanes) {
+            continue;
+        }
+
+        double x0 = qMax(xAt(m_starts[i]), -1.0);
+        double x1 = qMin(xAt(m_ends[i]), double(width() + 1));
+        QRectF bar(x0, AXIS_HEIGHT + row * LANE_HEIGHT + 2, qMax(x1 - x0, 1.0), LANE_HEIGHT - 4);
+
+        const StatusData &status = *m_statuses[i];
+        painter.fillRect(bar, colorFor(status.icon));
+
+        if (bar.width() > 40) {
+            QString text = metrics.elidedText(status.icon + " " + status.description,
+                                              Qt::ElideRight, static_cast<int>(bar.width()) - 8);
+            painter.setPen(QColor(51, 51, 51));
+            painter.drawText(bar.adjusted(4, 0, -4, 0), Qt::AlignVCenter | Qt::AlignLeft, text);
+        }
+    }
+}
+
+int TimelineWidget::barAt(const QPoint &pos) const {
+    if (pos.y() < AXIS_HEIGHT) {
+        return -1;
+    }
+
+    QVector<int> visible;
+    if (!visibleBars(m_viewStart, timeAt(width()), MAX_VISIBLE_BARS, visible)) {
+        return -1;
+    }
+
+    int lane = (pos.y() - AXIS_HEIGHT) / LANE_HEIGHT + m_laneOffset;
+    qint64 t = timeAt(pos.x());
+    for (int i : std::as_const(visible)) {
+        if (m_lanes[i] == lane && m_starts[i] <= t && t < m_ends[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool TimelineWidget::event(QEvent *event) {
+    if (event->type() == QEvent::ToolTip) {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        int index = barAt(helpEvent->pos());
+        if (index >= 0) {
+            const StatusData &status = *m_statuses[index];
+            QToolTip::showText(helpEvent->globalPos(),
+                               QString("%1 %2\n%3").arg(status.icon, status.description, status.getTimeRange()),
+                               this);
+        } else {
+            QToolTip::hideText();
+            event->ignore();
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+void TimelineWidget::wheelEvent(QWheelEvent *event) {
+    double steps = event->angleDelta().y() / 120.0;
+    if (event->modifiers() & Qt::ShiftModifier) {
+        // Shift + 滚轮：上下滚动行
+        m_laneOffset = qBound(0, m_laneOffset - static_cast<int>(steps * 3), qMax(0, m_laneCount - 1));
+    } else {
+        // 以鼠标位置为中心缩放
+        double x = event->position().x();
+        qint64 anchor = timeAt(x);
+        m_secsPerPixel = qBound(kMinSecsPerPixel, m_secsPerPixel * qPow(0.8, steps), maxSecsPerPixel());
+        m_viewStart = anchor - static_cast<qint64>(x * m_secsPerPixel);
+    }
+    update();
+    event->accept();
+}
+
+void TimelineWidget::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_panning = true;
+        m_panAnchor = event->position().toPoint();
+        m_panStartTime = m_viewStart;
+        m_panStartLane = m_laneOffset;
+        setCursor(Qt::ClosedHandCursor);
+        event->accept();
+    }
+}
+
+void TimelineWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (m_panning && (event->buttons() & Qt::LeftButton)) {
+        QPoint delta = event->position().toPoint() - m_panAnchor;
+        m_viewStart = m_panStartTime - static_cast<qint64>(delta.x() * m_secsPerPixel);
+        m_laneOffset = qBound(0, m_panStartLane - delta.y() / LANE_HEIGHT, qMax(0, m_laneCount - 1));
+        update();
+        event->accept();
+    }
+}
+
+void TimelineWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_panning = false;
+        unsetCursor();
+    }
+}
+
+void TimelineWidget::mouseDoubleClickEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        fitAll();
+    }
+}
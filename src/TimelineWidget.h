@@ -0,0 +1,127 @@
+#ifndef TIMELINEWIDGET_H
+#define TIMELINEWIDGET_H
+
+#include <QWidget>
+#include <QVector>
+#include <QPoint>
+#include "StatusManager.h"
+
+class QPainter;
+
+/**
+ * @brief 时间线视图，以甘特图形式显示所有状态
+ *
+ * 支持滚轮缩放、拖动平移。缩放较粗时使用预先计算的多级分辨率汇总
+ * 绘制密度带，缩放较细时只绘制可见区域内的状态条。
+ */
+class TimelineWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit TimelineWidget(StatusManager *manager, QWidget *parent = nullptr);
+
+    QSize sizeHint() const override;
+
+public slots:
+    /**
+     * @brief 缩放到显示全部状态
+     */
+    void fitAll();
+
+protected:
+    bool event(QEvent *event) override;
+
+    void paintEvent(QPaintEvent *event) override;
+
+    void showEvent(QShowEvent *event) override;
+
+    void wheelEvent(QWheelEvent *event) override;
+
+    void mousePressEvent(QMouseEvent *event) override;
+
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private slots:
+    void onStatusesChanged();
+
+private:
+    /**
+     * @brief 重新生成状态条数据与多级汇总
+     */
+    void rebuild();
+
+    void buildLanes();
+
+    void buildLevels();
+
+    /**
+     * @brief 选择每个桶至少占一个像素的最细汇总级别
+     */
+    int levelFor(double secsPerPixel) const;
+
+    void buildEndTree();
+
+    /**
+     * @brief 与时间段 [from, to) 相交的状态下标（按起始时间升序），最多取 limit + 1 个
+     * @return 相交的状态不超过 limit 个时返回true
+     */
+    bool visibleBars(qint64 from, qint64 to, int limit, QVector<int> &indices) const;
+
+    void paintAxis(QPainter &painter, qint64 viewEnd);
+
+    void paintDensity(QPainter &painter, qint64 viewEnd);
+
+    void paintBars(QPainter &painter, const QVector<int> &indices);
+
+    int barAt(const QPoint &pos) const;
+
+    /**
+     * @brief 缩小时每像素秒数的上限：至少10年或数据跨度的两倍铺满宽度，避免时间换算溢出
+     */
+    double maxSecsPerPixel() const;
+
+    qint64 timeAt(double x) const;
+
+    double xAt(qint64 secs) const;
+
+    StatusManager *m_statusManager;
+    bool m_dirty;
+
+    // 状态条（按起始时间排序，与 m_statuses 一一对应）
+    // m_statuses 指向 StatusManager 合并视图中的元素，每次 statusesChanged 后重建，隐藏期间不使用
+    QVector<const StatusData *> m_statuses;
+    QVector<qint64> m_starts;
+    QVector<qint64> m_ends;
+    QVector<int> m_lanes;
+
+    // 按起始时间顺序的结束时间最大值线段树：叶子 m_endTree[m_endTreeLeaves + i] = m_ends[i]
+    QVector<qint64> m_endTree;
+    int m_endTreeLeaves;
+    int m_laneCount;
+
+    // 多级汇总：第L级每个桶宽 m_bucketSecs * 4^L 秒，记录桶内最大并发数
+    QVector<QVector<int>> m_levels;
+    qint64 m_origin;
+    qint64 m_bucketSecs;
+    int m_peak;
+
+    // 视图状态
+    qint64 m_viewStart;
+    double m_secsPerPixel;
+    int m_laneOffset;
+    bool m_panning;
+    QPoint m_panAnchor;
+    qint64 m_panStartTime;
+    int m_panStartLane;
+
+    static const int AXIS_HEIGHT = 24;
+    static const int LANE_HEIGHT = 22;
+    static const int LEVEL_FANOUT = 4;
+    static const int MAX_VISIBLE_BARS = 4000; // 超过此数量时改为绘制密度带
+};
+
+#endif // TIMELINEWIDGET_H
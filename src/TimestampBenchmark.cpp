@@ -0,0 +1,238 @@
+#include "TimestampBenchmark.h"
+#include "IsoTimestamp.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTimeZone>
+#include <cstdio>
+
+namespace {
+    bool sameResult(const QDateTime &lhs, const QDateTime &rhs) {
+        if (lhs.isValid() != rhs.isValid()) {
+            return false;
+        }
+        return !lhs.isValid()
+               || (lhs == rhs && lhs.offsetFromUtc() == rhs.offsetFromUtc() && lhs.timeSpec() == rhs.timeSpec());
+    }
+
+    QString describe(const QDateTime &dateTime) {
+        if (!dateTime.isValid()) {
+            return "invalid";
+        }
+        return dateTime.toString(Qt::ISODateWithMs) + QString(" offset=%1").arg(dateTime.offsetFromUtc());
+    }
+
+    QString fieldsText(int year, int month, int day, int hour, int minute, int second) {
+        return QString::asprintf("%04d-%02d-%02dT%02d:%02d:%02d", year, month, day, hour, minute, second);
+    }
+
+    /**
+     * @brief 以UTC秒数表示的“本地墙上时间”转为固定格式字符串
+     */
+    QString wallText(qint64 wallSecs) {
+        return QDateTime::fromSecsSinceEpoch(wallSecs, QTimeZone::utc()).toString("yyyy-MM-ddThh:mm:ss");
+    }
+}
+
+TimestampBenchmark::TimestampBenchmark()
+    : m_seed(20260211)
+      , m_iterations(200000)
+      , m_cases(0)
+      , m_mismatches(0) {
+}
+
+void TimestampBenchmark::configure(const QStringList &arguments) {
+    for (const QString &argument : arguments) {
+        if (!argument.startsWith("--") || !argument.contains('=')) {
+            continue;
+        }
+        const QString key = argument.mid(2).section('=', 0, 0);
+        bool ok = false;
+        const qint64 value = argument.section('=', 1).toLongLong(&ok);
+        if (!ok) {
+            qWarning() << "无效的参数值:" << argument;
+        } else if (key == "seed") {
+            m_seed = quint32(value);
+        } else if (key == "iterations") {
+            m_iterations = int(value);
+        } else {
+            qWarning() << "未知参数:" << argument;
+        }
+    }
+}
+
+QStringList TimestampBenchmark::makeCases() {
+    QStringList cases = {
+        "2026-02-11T09:00:00", "2000-02-29T12:00:00", "1900-02-29T12:00:00", "2024-02-29T00:00:00",
+        "2023-02-29T00:00:00", "2023-04-31T00:00:00", "0000-01-01T00:00:00", "0001-01-01T00:00:00",
+        "9999-12-31T23:59:59", "1970-01-01T00:00:00", "1969-12-31T23:59:59", "2038-01-19T03:14:08",
+        "2026-02-11T24:00:00", "2026-02-11T23:60:00", "2026-02-11T23:59:60", "2026-13-01T00:00:00",
+        "2026-00-10T00:00:00", "2026-02-00T00:00:00", "2026-02-11 09:00:00", "2026-02-11t09:00:00",
+        "2026-02-11T09:00", "2026-02-11", "2026-02-11T09:00:00Z", "2026-02-11T09:00:00+08:00",
+        "2026-02-11T09:00:00.123", "２０２６-02-11T09:00:00", "2026-02-11T0٩:00:00", "", "garbage",
+        "2026/02/11T09:00:00", "+2026-02-11T09:00:", "2026-02-11T09:00:0/", "2026-02-11T09:00:0:",
+    };
+
+    // 本地时区前后几年的夏令时切换：切换前后的墙上时间按两种偏移各生成一组
+    const QTimeZone zone = QTimeZone::systemTimeZone();
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (const QTimeZone::OffsetData &transition : zone.transitions(now.addYears(-3), now.addYears(3))) {
+        const qint64 at = transition.atUtc.toSecsSinceEpoch();
+        const int before = zone.offsetFromUtc(transition.atUtc.addSecs(-1));
+        for (int offset : {before, transition.offsetFromUtc}) {
+            for (qint64 delta = -3 * 3600; delta <= 3 * 3600; delta += 900) {
+                cases << wallText(at + offset + delta) << wallText(at + offset + delta + 59);
+            }
+        }
+    }
+
+    QRandomGenerator random(m_seed);
+    const QString pool = "0123456789-:T tZz+./٣０";
+    const QStringList suffixes = {"Z", "+08:00", "-05:30", ".123", ".5Z", " ", "T"};
+    for (int i = 0; i < RANDOM_CASES; ++i) {
+        // 大部分取值合法，小部分越界
+        const int year = random.bounded(2) ? random.bounded(1900, 2101) : random.bounded(0, 10000);
+        const int month = random.bounded(10) ? random.bounded(1, 13) : random.bounded(0, 14);
+        const int day = random.bounded(10) ? random.bounded(1, 29) : random.bounded(0, 33);
+        const int hour = random.bounded(10) ? random.bounded(0, 24) : random.bounded(0, 26);
+        const int minute = random.bounded(10) ? random.bounded(0, 60) : random.bounded(0, 62);
+        const int second = random.bounded(10) ? random.bounded(0, 60) : random.bounded(0, 62);
+        QString text = fieldsText(year, month, day, hour, minute, second);
+        cases << text;
+
+        const int position = random.bounded(text.size());
+        switch (random.bounded(6)) {
+            case 0: text[position] = pool[random.bounded(pool.size())]; break;
+            case 1: text.remove(position, 1); break;
+            case 2: text.insert(position, pool[random.bounded(pool.size())]); break;
+            case 3: text += suffixes[random.bounded(suffixes.size())]; break;
+            case 4: text.truncate(10); break;
+            default: text[10] = u't'; break;
+        }
+        cases << text;
+    }
+    return cases;
+}
+
+void TimestampBenchmark::reportMismatch(const QString &what, const QString &input, const QString &fast,
+                                        const QString &qt) {
+    if (++m_mismatches <= MAX_REPORTED) {
+        std::printf("timestamp-bench mismatch %s input=\"%s\" fast=\"%s\" qt=\"%s\"\n", qPrintable(what),
+                    qPrintable(input), qPrintable(fast), qPrintable(qt));
+    }
+}
+
+void TimestampBenchmark::checkParse(const QString &text) {
+    ++m_cases;
+    const QDateTime fast = IsoTimestamp::parse(text);
+    const QDateTime qt = QDateTime::fromString(text, Qt::ISODate);
+    if (!sameResult(fast, qt)) {
+        reportMismatch("parse", text, describe(fast), describe(qt));
+    }
+    if (qt.isValid()) {
+        checkFormat(qt);
+    }
+}
+
+void TimestampBenchmark::checkFormat(const QDateTime &dateTime) {
+    ++m_cases;
+    const QString input = describe(dateTime);
+    const QString iso = dateTime.toString(Qt::ISODate);
+    if (IsoTimestamp::format(dateTime) != iso) {
+        reportMismatch("format", input, IsoTimestamp::format(dateTime), iso);
+    }
+
+    const struct {
+        IsoTimestamp::DisplayLayout layout;
+        const char *pattern;
+    } layouts[] = {
+        {IsoTimestamp::DateTimeMinutes, "yyyy-MM-dd hh:mm"},
+        {IsoTimestamp::MonthDayMinutes, "MM-dd hh:mm"},
+        {IsoTimestamp::Minutes, "hh:mm"},
+    };
+    for (const auto &entry : layouts) {
+        const QString fast = IsoTimestamp::formatDisplay(dateTime, entry.layout);
+        const QString qt = dateTime.toString(entry.pattern);
+        if (fast != qt) {
+            reportMismatch(QString("display(%1)").arg(entry.pattern), input, fast, qt);
+        }
+    }
+}
+
+int TimestampBenchmark::run() {
+    // 差异测试
+    const QStringList cases = makeCases();
+    for (const QString &text : cases) {
+        checkParse(text);
+    }
+
+    // 旧格式（仅小时）在夏令时切换日及随机日期的每个小时
+    QRandomGenerator random(m_seed + 1);
+    QList<QDate> legacyDates;
+    const QTimeZone zone = QTimeZone::systemTimeZone();
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (const QTimeZone::OffsetData &transition : zone.transitions(now.addYears(-3), now.addYears(3))) {
+        legacyDates << transition.atUtc.toLocalTime().date();
+    }
+    for (int i = 0; i < 200; ++i) {
+        legacyDates << QDate(1970, 1, 1).addDays(random.bounded(60000));
+    }
+    for (const QDate &date : std::as_const(legacyDates)) {
+        for (int hour = 0; hour < 24; ++hour) {
+            ++m_cases;
+            const QDateTime fast = IsoTimestamp::fromLegacyHour(date, hour);
+            const QDateTime qt(date, QTime(hour, 0));
+            if (!sameResult(fast, qt)) {
+                reportMismatch("legacy-hour", date.toString(Qt::ISODate) + QString(" %1h").arg(hour),
+                               describe(fast), describe(qt));
+            }
+        }
+    }
+
+    std::printf("timestamp-bench cases=%d mismatches=%d\n", m_cases, m_mismatches);
+    std::fflush(stdout);
+
+    // 性能：只用合法的固定格式字符串，对应加载 status.json 的情况
+    QStringList inputs;
+    inputs.reserve(m_iterations);
+    for (int i = 0; i < m_iterations; ++i) {
+        inputs << fieldsText(random.bounded(1990, 2060), random.bounded(1, 13), random.bounded(1, 29),
+                             random.bounded(0, 24), random.bounded(0, 60), random.bounded(0, 60));
+    }
+    QList<QDateTime> values;
+    values.reserve(m_iterations);
+
+    QElapsedTimer timer;
+    qint64 checksum = 0;
+    timer.start();
+    for (const QString &text : std::as_const(inputs)) {
+        checksum += IsoTimestamp::parse(text).toSecsSinceEpoch();
+    }
+    const qint64 parseFast = timer.nsecsElapsed();
+
+    timer.restart();
+    for (const QString &text : std::as_const(inputs)) {
+        values << QDateTime::fromString(text, Qt::ISODate);
+    }
+    const qint64 parseQt = timer.nsecsElapsed();
+
+    timer.restart();
+    for (const QDateTime &value : std::as_const(values)) {
+        checksum += IsoTimestamp::format(value).size();
+    }
+    const qint64 formatFast = timer.nsecsElapsed();
+
+    timer.restart();
+    for (const QDateTime &value : std::as_const(values)) {
+        checksum += value.toString(Qt::ISODate).size();
+    }
+    const qint64 formatQt = timer.nsecsElapsed();
+
+    const double count = qMax(1, m_iterations);
+    std::printf("timestamp-bench parse-fast-ns=%.0f parse-qt-ns=%.0f format-fast-ns=%.0f format-qt-ns=%.0f "
+                "checksum=%lld\n",
+                parseFast / count, parseQt / count, formatFast / count, formatQt / count,
+                static_cast<long long>(checksum));
+    std::fflush(stdout);
+    return m_mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#ifndef TIMESTAMPBENCHMARK_H
+#define TIMESTAMPBENCHMARK_H
+
+#include <QDateTime>
+#include <QStringList>
+
+/**
+ * @brief 时间戳编解码的差异测试与性能测量（--timestamp-bench）
+ *
+ * 用随机生成、随机变异和边界情况（闰日、年份边界、本地时区的夏令时切换前后）的字符串，
+ * 逐个比较 IsoTimestamp::parse 与 QDateTime::fromString(Qt::ISODate) 的结果，
+ * 以及格式化函数与 QDateTime::toString 的结果；再分别测量两者的耗时。输出：
+ *     timestamp-bench cases=.. mismatches=0
+ *     timestamp-bench parse-fast-ns=.. parse-qt-ns=.. format-fast-ns=.. format-qt-ns=.. checksum=..
+ * 有不一致时列出前几个并以1退出。参数 --seed=N、--iterations=N 可调整随机种子和测量次数。
+ */
+class TimestampBenchmark {
+public:
+    TimestampBenchmark();
+
+    /**
+     * @brief 读取 --名称=值 形式的参数
+     */
+    void configure(const QStringList &arguments);
+
+    /**
+     * @brief 运行差异测试和性能测量
+     * @return 退出码，有不一致时为1
+     */
+    int run();
+
+private:
+    /**
+     * @brief 生成测试字符串：边界情况、随机合法格式、随机变异
+     */
+    QStringList makeCases();
+
+    void checkParse(const QString &text);
+
+    void checkFormat(const QDateTime &dateTime);
+
+    void reportMismatch(const QString &what, const QString &input, const QString &fast, const QString &qt);
+
+    quint32 m_seed;
+    int m_iterations;
+    int m_cases;
+    int m_mismatches;
+
+    static const int RANDOM_CASES = 50000;
+    static const int MAX_REPORTED = 20;
+};
+
+#endif // TIMESTAMPBENCHMARK_H
@@ -0,0 +1,278 @@
+#include "TimingWheel.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+    /**
+     * @brief 第 level 层一个槽覆盖的秒数的位数
+     */
+    constexpr int levelShift(int level) {
+        return level * 8;
+    }
+}
+
+TimingWheel::TimingWheel(qint64 now)
+    : m_freeList(NIL)
+      , m_overflow(NIL)
+      , m_due(NIL)
+      , m_now(now)
+      , m_size(0) {
+    reset(now);
+}
+
+void TimingWheel::reset(qint64 now) {
+    // 节点池保留，已占用的节点加代数，旧句柄全部失效
+    m_freeList = NIL;
+    for (qint32 i = qint32(m_nodes.size()) - 1; i >= 0; --i) {
+        Node &node = m_nodes[i];
+        if (node.level >= 0) {
+            node.generation = node.generation + 1 ? node.generation + 1 : 1;
+            node.level = -1;
+        }
+        node.next = m_freeList;
+        m_freeList = i;
+    }
+    for (auto &heads : m_heads) {
+        heads.fill(NIL);
+    }
+    for (auto &bits : m_occupied) {
+        bits.fill(0);
+    }
+    m_overflow = NIL;
+    m_due = NIL;
+    m_now = now;
+    m_size = 0;
+}
+
+qint32 &TimingWheel::head(int level, int slot) {
+    if (level == OVERFLOW_LEVEL) {
+        return m_overflow;
+    }
+    if (level == DUE_LEVEL) {
+        return m_due;
+    }
+    return m_heads[level][slot];
+}
+
+void TimingWheel::link(qint32 index) {
+    Node &node = m_nodes[index];
+    qint32 &first = head(node.level, node.slot);
+    node.prev = NIL;
+    node.next = first;
+    if (first != NIL) {
+        m_nodes[first].prev = index;
+    }
+    first = index;
+    if (node.level < LEVELS) {
+        m_occupied[node.level][node.slot / 64] |= quint64(1) << (node.slot % 64);
+    }
+}
+
+void TimingWheel::unlink(qint32 index) {
+    Node &node = m_nodes[index];
+    if (node.next != NIL) {
+        m_nodes[node.next].prev = node.prev;
+    }
+    if (node.prev != NIL) {
+        m_nodes[node.prev].next = node.next;
+        return;
+    }
+    qint32 &first = head(node.level, node.slot);
+    first = node.next;
+    if (first == NIL && node.level < LEVELS) {
+        m_occupied[node.level][node.slot / 64] &= ~(quint64(1) << (node.slot % 64));
+    }
+}
+
+void TimingWheel::release(qint32 index) {
+    Node &node = m_nodes[index];
+    node.generation = node.generation + 1 ? node.generation + 1 : 1;
+    node.level = -1;
+    node.next = m_freeList;
+    m_freeList = index;
+    --m_size;
+}
+
+void TimingWheel::place(qint32 index) {
+    Node &node = m_nodes[index];
+    const qint64 delta = node.expires - m_now;
+
+    if (delta < 0) {
+        // 已过期，下一次推进时到期
+        node.level = DUE_LEVEL;
+        node.slot = 0;
+    } else if (delta < SLOTS) {
+        node.level = 0;
+        node.slot = qint16(node.expires & SLOT_MASK);
+    } else {
+        node.level = OVERFLOW_LEVEL;
+        node.slot = 0;
+        for (int level = 1; level < LEVELS; ++level) {
+            if (delta < qint64(1) << levelShift(level + 1)) {
+                node.level = qint16(level);
+                node.slot = qint16((node.expires >> levelShift(level)) & SLOT_MASK);
+                break;
+            }
+        }
+    }
+    link(index);
+}
+
+TimingWheel::Handle TimingWheel::schedule(qint64 expires, quint64 payload) {
+    qint32 index = m_freeList;
+    if (index != NIL) {
+        m_freeList = m_nodes[index].next;
+    } else {
+        index = qint32(m_nodes.size());
+        Node node;
+        node.generation = 1;
+        m_nodes.push_back(node);
+    }
+
+    Node &node = m_nodes[index];
+    node.expires = expires;
+    node.payload = payload;
+    place(index);
+    ++m_size;
+    return (Handle(node.generation) << 32) | quint32(index);
+}
+
+bool TimingWheel::cancel(Handle handle) {
+    const quint32 index = quint32(handle);
+    if (index >= m_nodes.size()) {
+        return false;
+    }
+    const Node &node = m_nodes[index];
+    if (node.level < 0 || node.generation != quint32(handle >> 32)) {
+        return false;
+    }
+    unlink(qint32(index));
+    release(qint32(index));
+    return true;
+}
+
+void TimingWheel::cascade(int level, int slot) {
+    qint32 index = head(level, slot);
+    if (index == NIL) {
+        return;
+    }
+    head(level, slot) = NIL;
+    if (level < LEVELS) {
+        m_occupied[level][slot / 64] &= ~(quint64(1) << (slot % 64));
+    }
+    while (index != NIL) {
+        const qint32 next = m_nodes[index].next;
+        place(index);
+        index = next;
+    }
+}
+
+int TimingWheel::nextOccupied(int level, int from) const {
+    for (int word = from / 64; word < BITMAP_WORDS; ++word) {
+        quint64 bits = m_occupied[level][word];
+        if (word == from / 64) {
+            bits &= ~quint64(0) << (from % 64);
+        }
+        if (bits) {
+            return word * 64 + std::countr_zero(bits);
+        }
+    }
+    return -1;
+}
+
+bool TimingWheel::levelEmpty(int level) const {
+    for (quint64 bits : m_occupied[level]) {
+        if (bits) {
+            return false;
+        }
+    }
+    return true;
+}
+
+qint64 TimingWheel::idleTarget() const {
+    // 第0层本圈剩余的槽为空；各层当前槽已下放过，其中的事件属于下一圈
+    for (int level = 1; level <= LEVELS; ++level) {
+        const qint64 span = qint64(1) << levelShift(level);
+        if (!levelEmpty(level - 1)) {
+            return (m_now | (span - 1)) + 1; // 下一层的下一个槽的起点
+        }
+        if (level == LEVELS) {
+            break;
+        }
+        const int slot = int((m_now >> levelShift(level)) & SLOT_MASK);
+        const int next = slot + 1 < SLOTS ? nextOccupied(level, slot + 1) : -1;
+        if (next >= 0) {
+            const qint64 base = m_now & ~((qint64(1) << levelShift(level + 1)) - 1);
+            return base + (qint64(next) << levelShift(level));
+        }
+    }
+    if (m_overflow != NIL) {
+        return (m_now | ((qint64(1) << levelShift(LEVELS)) - 1)) + 1;
+    }
+    return -1;
+}
+
+void TimingWheel::advance(qint64 now, std::vector<Expired> &expired) {
+    const size_t first = expired.size();
+    for (qint32 node = m_due; node != NIL;) {
+        const qint32 next = m_nodes[node].next;
+        expired.push_back({m_nodes[node].payload, m_nodes[node].expires});
+        release(node);
+        node = next;
+    }
+    m_due = NIL;
+    std::stable_sort(expired.begin() + first, expired.end(),
+                     [](const Expired &lhs, const Expired &rhs) { return lhs.expires < rhs.expires; });
+
+    while (m_now <= now) {
+        const int index = int(m_now & SLOT_MASK);
+
+        if (index == 0) {
+            // 自高向低下放，高层下放的事件可能落入随后下放的低层槽
+            if ((m_now & ((qint64(1) << levelShift(LEVELS)) - 1)) == 0) {
+                cascade(OVERFLOW_LEVEL, 0);
+            }
+            for (int level = LEVELS - 1; level >= 1; --level) {
+                if ((m_now & ((qint64(1) << levelShift(level)) - 1)) == 0) {
+                    cascade(level, int((m_now >> levelShift(level)) & SLOT_MASK));
+                }
+            }
+        }
+
+        qint32 node = m_heads[0][index];
+        m_heads[0][index] = NIL;
+        m_occupied[0][index / 64] &= ~(quint64(1) << (index % 64));
+        while (node != NIL) {
+            const qint32 next = m_nodes[node].next;
+            expired.push_back({m_nodes[node].payload, m_nodes[node].expires});
+            release(node);
+            node = next;
+        }
+
+        // 跳到下一个占用的槽；本圈剩余为空时跳过空闲的时间段，追赶的开销与跨越的秒数基本无关
+        const int next = index + 1 < SLOTS ? nextOccupied(0, index + 1) : -1;
+        qint64 target = next >= 0 ? m_now - index + next : idleTarget();
+        if (target < 0 || target > now) {
+            target = now + 1;
+        }
+        m_now = target;
+    }
+}
+
+qint64 TimingWheel::nextWakeup() const {
+    if (m_size == 0) {
+        return -1;
+    }
+    if (m_due != NIL) {
+        return m_nodes[m_due].expires;
+    }
+    const int index = int(m_now & SLOT_MASK);
+    if (index == 0) {
+        return m_now; // 一圈的起点尚未处理，可能有事件下放
+    }
+    const int next = nextOccupied(0, index);
+    if (next >= 0) {
+        return m_now - index + next;
+    }
+    return idleTarget();
+}
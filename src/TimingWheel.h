@@ -0,0 +1,127 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <QtGlobal>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 分层时间轮，时间单位为秒（UTC秒数）
+ *
+ * 4层、每层256个槽，第0层精确到秒，逐层粒度乘以256，覆盖约136年，更远的事件放在溢出链表，
+ * 安排时已过期的事件放在到期链表。
+ * 事件节点存放在节点池中，以双向链表挂在槽上：
+ * - schedule() 和 cancel() 均为 O(1)
+ * - advance() 处理到期事件，高层槽在低层转完一圈时下放；
+ *   空槽和空闲的时间段通过占用位图整段跳过，长时间休眠后追赶的开销与跨越的秒数基本无关
+ *
+ * 到期事件写入输出列表而不是回调，调用方可以在处理过程中安全地增删事件。
+ */
+class TimingWheel {
+public:
+    typedef quint64 Handle;
+
+    static constexpr Handle InvalidHandle = 0;
+
+    /**
+     * @brief 到期的事件
+     */
+    struct Expired {
+        quint64 payload;
+        qint64 expires;
+    };
+
+    explicit TimingWheel(qint64 now = 0);
+
+    /**
+     * @brief 清空所有事件，并把当前时间设为 now
+     */
+    void reset(qint64 now);
+
+    /**
+     * @brief 安排事件，expires 早于当前时间时在下一次 advance() 到期
+     * @return 用于取消的句柄
+     */
+    Handle schedule(qint64 expires, quint64 payload);
+
+    /**
+     * @brief 取消事件，句柄已到期或已取消时返回false
+     */
+    bool cancel(Handle handle);
+
+    /**
+     * @brief 推进到 now（含），按时间顺序把到期事件追加到 expired
+     */
+    void advance(qint64 now, std::vector<Expired> &expired);
+
+    /**
+     * @brief 下一次需要调用 advance() 的时间（不晚于最早的事件），没有事件时返回-1
+     */
+    qint64 nextWakeup() const;
+
+    /**
+     * @brief 下一个尚未处理的秒
+     */
+    qint64 currentTime() const { return m_now; }
+
+    qsizetype size() const { return m_size; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int SLOT_MASK = SLOTS - 1;
+    static constexpr int BITMAP_WORDS = SLOTS / 64;
+    static constexpr int OVERFLOW_LEVEL = LEVELS;
+    static constexpr int DUE_LEVEL = LEVELS + 1;
+    static constexpr qint32 NIL = -1;
+
+    struct Node {
+        qint64 expires;
+        quint64 payload;
+        qint32 prev;
+        qint32 next;
+        quint32 generation; // 每次释放加一，旧句柄因此失效
+        qint16 level;       // -1 表示空闲
+        qint16 slot;
+    };
+
+    qint32 &head(int level, int slot);
+
+    void link(qint32 index);
+
+    void unlink(qint32 index);
+
+    void release(qint32 index);
+
+    void place(qint32 index);
+
+    /**
+     * @brief 把某层某槽的事件按当前时间重新放置
+     */
+    void cascade(int level, int slot);
+
+    /**
+     * @brief 在 [from, SLOTS) 中查找第一个占用的槽，没有返回-1
+     */
+    int nextOccupied(int level, int from) const;
+
+    bool levelEmpty(int level) const;
+
+    /**
+     * @brief 第0层本圈剩余为空时，下一个可能有事件的时间（槽的起点），没有事件返回-1
+     */
+    qint64 idleTarget() const;
+
+    std::vector<Node> m_nodes;
+    qint32 m_freeList;
+    std::array<std::array<qint32, SLOTS>, LEVELS> m_heads;
+    std::array<std::array<quint64, BITMAP_WORDS>, LEVELS> m_occupied;
+    qint32 m_overflow; // 超出时间轮范围的事件
+    qint32 m_due;      // 安排时已过期的事件
+    qint64 m_now;
+    qsizetype m_size;
+};
+
+#endif // TIMINGWHEEL_H
@@ -1,12 +1,81 @@
 #include <QApplication>
 #include <QFile>
 #include <QDir>
+#include <QFileInfo>
 #include <QMessageBox>
+#include <QSettings>
+#include <QElapsedTimer>
 #include "MainWindow.h"
 #include "StatusManager.h"
+#include "ActiveSnapshotPublisher.h"
+#include "SyncService.h"
+#include "ProviderScheduler.h"
+#include "StartupSnapshot.h"
+#include "StartupBenchmark.h"
+#include "StatusEventHooks.h"
+#include "SingleInstance.h"
+#include "GuiStressHarness.h"
+#include "TimestampBenchmark.h"
+#include "QueryBenchmark.h"
+#include "SyncSelfTest.h"
+#include <algorithm>
+
+namespace {
+    bool hasArgument(int argc, char *argv[], const char *name) {
+        return std::any_of(argv + 1, argv + argc, [name](const char *argument) {
+            return qstrcmp(argument, name) == 0;
+        });
+    }
+}
 
 int main(int argc, char *argv[]) {
+    QElapsedTimer startupClock;
+    startupClock.start();
+
+    // 时间戳差异测试、查询分配测量和同步自检不涉及界面和用户数据，不受单实例限制
+    if (hasArgument(argc, argv, "--timestamp-bench")) {
+        QCoreApplication app(argc, argv);
+        TimestampBenchmark benchmark;
+        benchmark.configure(app.arguments().mid(1));
+        return benchmark.run();
+    }
+    if (hasArgument(argc, argv, "--query-bench")) {
+        QCoreApplication app(argc, argv);
+        QueryBenchmark benchmark;
+        benchmark.configure(app.arguments().mid(1));
+        return benchmark.run();
+    }
+    if (hasArgument(argc, argv, "--sync-selftest")) {
+        QCoreApplication app(argc, argv);
+        SyncSelfTest selfTest;
+        return selfTest.run();
+    }
+
+    // 界面压力测试使用独立的临时数据，不受单实例限制，默认不显示窗口
+    const bool guiStress = hasArgument(argc, argv, "--gui-stress");
+    if (guiStress && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // 同一数据目录只运行一个实例：之后启动的实例只转发参数后退出，不初始化界面也不加载数据
+    SingleInstance instance(QDir::currentPath());
+    if (!guiStress && !instance.tryLock()) {
+        // 启动测量必须由本进程完整启动，转发给已运行的实例就测不到，直接报错退出
+        if (hasArgument(argc, argv, "--startup-bench")) {
+            qWarning("startup-bench: 当前目录已有实例在运行，请先退出该实例再测量");
+            return 1;
+        }
+        QCoreApplication forwarder(argc, argv);
+        return instance.forward(forwarder.arguments().mid(1)) ? 0 : 1;
+    }
+
     QApplication app(argc, argv);
+    if (guiStress) {
+        GuiStressHarness harness;
+        harness.configure(app.arguments().mid(1));
+        return harness.run();
+    }
+    instance.listen();
 
     // 设置应用信息
     app.setApplicationName("状态显示应用");
@@ -28,16 +97,60 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    // 加载状态数据
-    if (!manager.loadFromFile(jsonPath)) {
-        QMessageBox::critical(nullptr, "错误",
-            "无法加载状态数据文件：" + jsonPath);
-        return 1;
+    // 注册数据源：个人文件为主数据源，sources目录下的JSON文件（团队、生成的日程等）为附加数据源
+    manager.addSource(jsonPath);
+    QDir sourcesDir(QDir::currentPath() + "/sources");
+    for (const QFileInfo &info : sourcesDir.entryInfoList({"*.json"}, QDir::Files, QDir::Name)) {
+        manager.addSource(info.absoluteFilePath());
     }
 
+    // 先用上次保存的启动快照显示，完整数据在后台并行加载
+    QString snapshotPath = QDir::currentPath() + "/status.snapshot";
+    manager.setProvisionalStatuses(StartupSnapshot::load(snapshotPath));
+    StartupSnapshot startupSnapshot(&manager, snapshotPath);
+
+    // 状态开始前提醒、开始、结束时的本地命令
+    StatusEventHooks eventHooks(&manager);
+    eventHooks.loadFromSettings();
+
+    // 发布当前有效状态到共享内存，供其他进程读取
+    ActiveSnapshotPublisher snapshotPublisher(&manager);
+    snapshotPublisher.start();
+
+    // 多设备同步（默认关闭）和后台状态提供者在首次完整加载后启动；
+    // 之后 --reload 触发的重新加载只替换数据，不再执行这里的初始化
+    SyncService syncService(&manager);
+    ProviderScheduler providerScheduler(&manager);
+    QObject::connect(&manager, &StatusManager::loadFinished, &app, [&](bool ok) {
+        if (!ok) {
+            QMessageBox::critical(nullptr, "错误",
+                "无法加载状态数据文件：" + jsonPath);
+            app.exit(1);
+            return;
+        }
+        if (QSettings("StatusApp", "StatusDisplayApp").value("sync/enabled", false).toBool()) {
+            syncService.startFromSettings();
+        }
+        // 后台状态提供者（日历文件、命令、监视目录），在工作线程中轮询
+        providerScheduler.loadFromSettings();
+    }, Qt::SingleShotConnection);
+
     // 创建并显示主窗口
     MainWindow window(&manager);
+
+    // 启动耗时测量：首次绘制与完整加载分别计时，输出后退出
+    StartupBenchmark *benchmark = nullptr;
+    if (app.arguments().contains("--startup-bench")) {
+        benchmark = new StartupBenchmark(&manager, startupClock, &app);
+        benchmark->watch(&window);
+    }
+
     window.show();
+    manager.loadAllSourcesAsync();
+
+    // 本实例的参数与其他实例转发的参数按同样方式处理
+    QObject::connect(&instance, &SingleInstance::argumentsReceived, &window, &MainWindow::handleArguments);
+    window.handleArguments(app.arguments().mid(1));
 
     return app.exec();
 }
\ No newline at end of file